@@ -0,0 +1,401 @@
+#include "ast_utils.h"
+#include <stdexcept>
+
+using namespace std;
+
+//=== COPIAS ===
+Exp* clone_exp(Exp* e) {
+    if (!e) return nullptr;
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        return new BinaryExp(clone_exp(b->left), clone_exp(b->right), b->op);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return new UnaryExp(clone_exp(u->exp), u->op);
+    } else if (auto n = dynamic_cast<NumberExp*>(e)) {
+        return new NumberExp(n->value);
+    } else if (auto s = dynamic_cast<StringExp*>(e)) {
+        return new StringExp(s->value);
+    } else if (auto b = dynamic_cast<BoolExp*>(e)) {
+        return new BoolExp(b->value);
+    } else if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        return new IdentifierExp(id->name);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        return new FieldAccessExp(clone_exp(fa->object), fa->field);
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        return new IndexExp(clone_exp(ix->array), clone_exp(ix->index));
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        return new SliceExp(clone_exp(sl->array), clone_exp(sl->start), clone_exp(sl->end));
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        list<Exp*> args;
+        for (auto arg : call->args) args.push_back(clone_exp(arg));
+        return new FunctionCallExp(call->funcName, args);
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        list<Exp*> values;
+        for (auto v : lit->values) values.push_back(clone_exp(v));
+        return new StructLiteralExp(lit->typeName, values, lit->fields);
+    }
+    throw runtime_error("clone_exp: expresión desconocida");
+}
+
+Type* clone_type(Type* t) {
+    if (!t) return nullptr;
+    if (auto bt = dynamic_cast<BasicType*>(t)) {
+        return new BasicType(bt->typeName);
+    } else if (auto it = dynamic_cast<IdentifierType*>(t)) {
+        return new IdentifierType(it->name);
+    } else if (auto st = dynamic_cast<StructType*>(t)) {
+        list<pair<string, Type*>> fields;
+        for (auto& f : st->fields) fields.push_back(make_pair(f.first, clone_type(f.second)));
+        return new StructType(fields);
+    }
+    throw runtime_error("clone_type: tipo desconocido");
+}
+
+Stmt* clone_stmt(Stmt* s) {
+    if (!s) return nullptr;
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        return new ExprStmt(clone_exp(es->expression));
+    } else if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        return new AssignStmt(clone_exp(as->lhs), clone_exp(as->rhs), as->op);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        list<Exp*> values;
+        for (auto v : sv->values) values.push_back(clone_exp(v));
+        return new ShortVarDecl(sv->identifiers, values);
+    } else if (auto id = dynamic_cast<IncDecStmt*>(s)) {
+        return new IncDecStmt(id->variable, id->isIncrement);
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        return new IfStmt(clone_exp(is->condition), clone_block(is->thenBlock), clone_block(is->elseBlock));
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        return new ForStmt(clone_stmt(fs->init), clone_exp(fs->condition), clone_stmt(fs->post), clone_block(fs->body));
+    } else if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        return new ReturnStmt(clone_exp(rs->expression));
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        list<Exp*> values;
+        for (auto v : vd->values) values.push_back(clone_exp(v));
+        return new VarDecl(vd->names, clone_type(vd->type), values);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        return new BlockStmt(clone_block(bs->block));
+    }
+    throw runtime_error("clone_stmt: sentencia desconocida");
+}
+
+Block* clone_block(Block* b) {
+    if (!b) return nullptr;
+    list<Stmt*> stmts;
+    for (auto s : b->statements) stmts.push_back(clone_stmt(s));
+    return new Block(stmts);
+}
+
+//=== CONSULTAS ===
+string exp_key(Exp* e) {
+    if (!e) return "_";
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        return "(" + Exp::binopToString(b->op) + " " + exp_key(b->left) + " " + exp_key(b->right) + ")";
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return "(" + Exp::unopToString(u->op) + " " + exp_key(u->exp) + ")";
+    } else if (auto n = dynamic_cast<NumberExp*>(e)) {
+        return to_string(n->value);
+    } else if (auto s = dynamic_cast<StringExp*>(e)) {
+        return "\"" + s->value + "\"";
+    } else if (auto b = dynamic_cast<BoolExp*>(e)) {
+        return b->value ? "true" : "false";
+    } else if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        return id->name;
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        return exp_key(fa->object) + "." + fa->field;
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        return exp_key(ix->array) + "[" + exp_key(ix->index) + "]";
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        return exp_key(sl->array) + "[" + exp_key(sl->start) + ":" + exp_key(sl->end) + "]";
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        string key = call->funcName + "(";
+        for (auto arg : call->args) key += exp_key(arg) + ",";
+        return key + ")";
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        string key = lit->typeName + "{";
+        for (auto v : lit->values) key += exp_key(v) + ",";
+        return key + "}";
+    }
+    return "?";
+}
+
+void collect_used_vars(Exp* e, set<string>& vars) {
+    if (!e) return;
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        collect_used_vars(b->left, vars);
+        collect_used_vars(b->right, vars);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        collect_used_vars(u->exp, vars);
+    } else if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        vars.insert(id->name);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        collect_used_vars(fa->object, vars);
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        collect_used_vars(ix->array, vars);
+        collect_used_vars(ix->index, vars);
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        collect_used_vars(sl->array, vars);
+        collect_used_vars(sl->start, vars);
+        collect_used_vars(sl->end, vars);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        for (auto arg : call->args) collect_used_vars(arg, vars);
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        for (auto v : lit->values) collect_used_vars(v, vars);
+    }
+}
+
+string lvalue_base(Exp* e) {
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) return id->name;
+    if (auto fa = dynamic_cast<FieldAccessExp*>(e)) return lvalue_base(fa->object);
+    if (auto ix = dynamic_cast<IndexExp*>(e)) return lvalue_base(ix->array);
+    return "";
+}
+
+void collect_modified_vars(Stmt* s, set<string>& vars) {
+    if (!s) return;
+    if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        string base = lvalue_base(as->lhs);
+        if (!base.empty()) vars.insert(base);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        for (auto& name : sv->identifiers) vars.insert(name);
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        for (auto& name : vd->names) vars.insert(name);
+    } else if (auto id = dynamic_cast<IncDecStmt*>(s)) {
+        vars.insert(id->variable);
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        collect_modified_vars(is->thenBlock, vars);
+        collect_modified_vars(is->elseBlock, vars);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        collect_modified_vars(fs->init, vars);
+        collect_modified_vars(fs->post, vars);
+        collect_modified_vars(fs->body, vars);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        collect_modified_vars(bs->block, vars);
+    }
+}
+
+void collect_modified_vars(Block* b, set<string>& vars) {
+    if (!b) return;
+    for (auto s : b->statements) collect_modified_vars(s, vars);
+}
+
+void collect_declared_vars(Block* b, set<string>& vars) {
+    if (!b) return;
+    for (auto s : b->statements) {
+        if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+            vars.insert(sv->identifiers.begin(), sv->identifiers.end());
+        } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+            vars.insert(vd->names.begin(), vd->names.end());
+        } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+            collect_declared_vars(is->thenBlock, vars);
+            collect_declared_vars(is->elseBlock, vars);
+        } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+            if (auto init = dynamic_cast<ShortVarDecl*>(fs->init)) {
+                vars.insert(init->identifiers.begin(), init->identifiers.end());
+            }
+            collect_declared_vars(fs->body, vars);
+        } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+            collect_declared_vars(bs->block, vars);
+        }
+    }
+}
+
+static ExpRewriter call_collector(set<string>& names) {
+    return [&](Exp* e) -> Exp* {
+        if (auto call = dynamic_cast<FunctionCallExp*>(e)) names.insert(call->funcName);
+        return nullptr;
+    };
+}
+
+void collect_called_functions(Block* b, set<string>& names) {
+    rewrite_block_exps(b, call_collector(names));
+}
+
+void collect_called_functions(Stmt* s, set<string>& names) {
+    rewrite_stmt_exps(s, call_collector(names));
+}
+
+void collect_called_functions(Exp* e, set<string>& names) {
+    rewrite_exp(e, call_collector(names));
+}
+
+bool calls_program_function(const set<string>& names) {
+    for (auto& name : names) {
+        if (name != "len" && name != "fmt.Println") return true;
+    }
+    return false;
+}
+
+bool always_returns(Block* b) {
+    if (!b || b->statements.empty()) return false;
+    Stmt* last = b->statements.back();
+    if (dynamic_cast<ReturnStmt*>(last)) return true;
+    if (auto is = dynamic_cast<IfStmt*>(last)) {
+        return always_returns(is->thenBlock) && always_returns(is->elseBlock);
+    }
+    if (auto bs = dynamic_cast<BlockStmt*>(last)) return always_returns(bs->block);
+    return false;
+}
+
+int count_nodes(Exp* e) {
+    if (!e) return 0;
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        return 1 + count_nodes(b->left) + count_nodes(b->right);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return 1 + count_nodes(u->exp);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        return 1 + count_nodes(fa->object);
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        return 1 + count_nodes(ix->array) + count_nodes(ix->index);
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        return 1 + count_nodes(sl->array) + count_nodes(sl->start) + count_nodes(sl->end);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        int n = 1;
+        for (auto arg : call->args) n += count_nodes(arg);
+        return n;
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        int n = 1;
+        for (auto v : lit->values) n += count_nodes(v);
+        return n;
+    }
+    return 1;
+}
+
+int count_nodes(Stmt* s) {
+    if (!s) return 0;
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        return 1 + count_nodes(es->expression);
+    } else if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        return 1 + count_nodes(as->lhs) + count_nodes(as->rhs);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        int n = 1;
+        for (auto v : sv->values) n += count_nodes(v);
+        return n;
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        return 1 + count_nodes(is->condition) + count_nodes(is->thenBlock) + count_nodes(is->elseBlock);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        return 1 + count_nodes(fs->init) + count_nodes(fs->condition) + count_nodes(fs->post) + count_nodes(fs->body);
+    } else if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        return 1 + count_nodes(rs->expression);
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        int n = 1;
+        for (auto v : vd->values) n += count_nodes(v);
+        return n;
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        return count_nodes(bs->block);
+    }
+    return 1;
+}
+
+int count_nodes(Block* b) {
+    if (!b) return 0;
+    int n = 0;
+    for (auto s : b->statements) n += count_nodes(s);
+    return n;
+}
+
+bool is_pure_exp(Exp* e) {
+    if (!e) return true;
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        return is_pure_exp(b->left) && is_pure_exp(b->right);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return is_pure_exp(u->exp);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        return is_pure_exp(fa->object);
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        return is_pure_exp(ix->array) && is_pure_exp(ix->index);
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        return is_pure_exp(sl->array) && is_pure_exp(sl->start) && is_pure_exp(sl->end);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        if (call->funcName != "len") return false;
+        for (auto arg : call->args) if (!is_pure_exp(arg)) return false;
+        return true;
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        for (auto v : lit->values) if (!is_pure_exp(v)) return false;
+        return true;
+    }
+    return true;
+}
+
+bool cannot_fail(Exp* e) {
+    if (!e || dynamic_cast<NumberExp*>(e) || dynamic_cast<StringExp*>(e) ||
+        dynamic_cast<BoolExp*>(e) || dynamic_cast<IdentifierExp*>(e)) {
+        return true;
+    }
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        if (b->op == DIV_OP || b->op == MOD_OP) {
+            // Dividir por cero falla, y el mínimo entero entre -1 también (idiv)
+            auto divisor = dynamic_cast<NumberExp*>(b->right);
+            if (!divisor || divisor->value == 0 || divisor->value == -1) return false;
+        }
+        return cannot_fail(b->left) && cannot_fail(b->right);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return cannot_fail(u->exp);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        return cannot_fail(fa->object);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        if (call->funcName != "len") return false;
+        for (auto arg : call->args) if (!cannot_fail(arg)) return false;
+        return true;
+    }
+    // Indexación, slices y literales de struct
+    return false;
+}
+
+//=== REESCRITURA ===
+Exp* rewrite_exp(Exp* e, const ExpRewriter& f) {
+    if (!e) return nullptr;
+    Exp* replacement = f(e);
+    if (replacement) return replacement;
+
+    if (auto b = dynamic_cast<BinaryExp*>(e)) {
+        b->left = rewrite_exp(b->left, f);
+        b->right = rewrite_exp(b->right, f);
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        u->exp = rewrite_exp(u->exp, f);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        fa->object = rewrite_exp(fa->object, f);
+    } else if (auto ix = dynamic_cast<IndexExp*>(e)) {
+        ix->array = rewrite_exp(ix->array, f);
+        ix->index = rewrite_exp(ix->index, f);
+    } else if (auto sl = dynamic_cast<SliceExp*>(e)) {
+        sl->array = rewrite_exp(sl->array, f);
+        sl->start = rewrite_exp(sl->start, f);
+        sl->end = rewrite_exp(sl->end, f);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        for (auto& arg : call->args) arg = rewrite_exp(arg, f);
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        for (auto& v : lit->values) v = rewrite_exp(v, f);
+    }
+    return e;
+}
+
+void rewrite_stmt_exps(Stmt* s, const ExpRewriter& f) {
+    if (!s) return;
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        es->expression = rewrite_exp(es->expression, f);
+    } else if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        as->rhs = rewrite_exp(as->rhs, f);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        for (auto& v : sv->values) v = rewrite_exp(v, f);
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        is->condition = rewrite_exp(is->condition, f);
+        rewrite_block_exps(is->thenBlock, f);
+        rewrite_block_exps(is->elseBlock, f);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        rewrite_stmt_exps(fs->init, f);
+        fs->condition = rewrite_exp(fs->condition, f);
+        rewrite_stmt_exps(fs->post, f);
+        rewrite_block_exps(fs->body, f);
+    } else if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        rs->expression = rewrite_exp(rs->expression, f);
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        for (auto& v : vd->values) v = rewrite_exp(v, f);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        rewrite_block_exps(bs->block, f);
+    }
+}
+
+void rewrite_block_exps(Block* b, const ExpRewriter& f) {
+    if (!b) return;
+    for (auto s : b->statements) rewrite_stmt_exps(s, f);
+}
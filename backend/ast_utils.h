@@ -0,0 +1,69 @@
+#ifndef AST_UTILS_H
+#define AST_UTILS_H
+
+#include <set>
+#include <string>
+#include <functional>
+#include "exp.h"
+
+using namespace std;
+
+// Utilidades compartidas por las pasadas de optimización sobre el AST
+
+// Copias profundas de nodos
+Exp* clone_exp(Exp* e);
+Stmt* clone_stmt(Stmt* s);
+Block* clone_block(Block* b);
+Type* clone_type(Type* t);
+
+// Representación textual canónica de una expresión, para comparar expresiones
+string exp_key(Exp* e);
+
+// Variables leídas por una expresión
+void collect_used_vars(Exp* e, set<string>& vars);
+
+// Nombre de la variable base de un lado izquierdo (x, x.campo, x.a.b); "" si no hay
+string lvalue_base(Exp* e);
+
+// Variables que una sentencia o bloque declara o modifica (asignaciones, ++/--,
+// escritura de campos de structs)
+void collect_modified_vars(Stmt* s, set<string>& vars);
+void collect_modified_vars(Block* b, set<string>& vars);
+
+// Nombres que declara un bloque (a cualquier profundidad)
+void collect_declared_vars(Block* b, set<string>& vars);
+
+// Nombres de todas las funciones llamadas dentro de un bloque, sentencia o expresión
+void collect_called_functions(Block* b, set<string>& names);
+void collect_called_functions(Stmt* s, set<string>& names);
+void collect_called_functions(Exp* e, set<string>& names);
+
+// true si algún nombre es una llamada a una función del programa (no a len ni a
+// fmt.Println): una llamada así puede escribir cualquier variable global
+bool calls_program_function(const set<string>& names);
+
+// true si el bloque termina en un return por todos sus caminos
+bool always_returns(Block* b);
+
+// Tamaño de un fragmento del AST en nodos, usado por los modelos de costo
+int count_nodes(Exp* e);
+int count_nodes(Stmt* s);
+int count_nodes(Block* b);
+
+// Una expresión es pura si no tiene efectos secundarios (solo se permite llamar a len)
+bool is_pure_exp(Exp* e);
+
+// Una expresión no puede fallar al ejecutarse si no divide por algo que no sea una
+// constante segura ni indexa o corta un string. Solo así se puede evaluar de forma
+// especulativa o descartar sin cambiar el comportamiento del programa
+bool cannot_fail(Exp* e);
+
+// Reescritura de expresiones. 'f' se aplica de arriba hacia abajo: si devuelve una
+// expresión (no nullptr) ésta reemplaza a la original, que queda a cargo de 'f', y no
+// se desciende dentro de ella. El lado izquierdo de las asignaciones no se visita.
+typedef function<Exp*(Exp*)> ExpRewriter;
+Exp* rewrite_exp(Exp* e, const ExpRewriter& f);
+void rewrite_stmt_exps(Stmt* s, const ExpRewriter& f);
+void rewrite_block_exps(Block* b, const ExpRewriter& f);
+
+#endif
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+import subprocess
+import os
+import sys
+import time
+
+# Carpeta de benchmarks
+benchmarks_dir = "benchmarks"
+
+# Carpeta temporal para los ensambladores y ejecutables
+bench_out_dir = "bench_outputs"
+
+# Archivos fuente del compilador
+source_files = [
+    "main.cpp", "scanner.cpp", "token.cpp", 
+    "parser.cpp", "exp.cpp", "visitor.cpp", 
+    "gencode.cpp", "imp_value.cpp", "helpers_gencode.cpp",
+    "ast_utils.cpp", "loop_opt.cpp", "inliner.cpp", "dce.cpp",
+    "escape.cpp", "fold.cpp", "evaluator.cpp"
+]
+
+executable = "main_bench"
+
+# Opciones con las que se compila la versión de referencia de cada benchmark.
+# Por defecto se comparan todas las optimizaciones contra -O0.
+baselines = {
+    "loops.go": ["-fno-licm", "-fno-strength-reduce"],
+    "unroll.go": ["-fno-unroll"],
+    "inline.go": ["-fno-inline"],
+    "structs1.go": ["-fno-struct-block-ops"],
+    "structs4.go": ["-fno-struct-block-ops"],
+    "structs16.go": ["-fno-struct-block-ops"],
+    "structs64.go": ["-fno-struct-block-ops"],
+    "builder.go": ["-fno-string-builder"],
+    "println.go": ["-fno-buffered-output"],
+    "alloc.go": ["-fno-arena"],
+    "gc.go": ["-fno-gc"],
+    "escape.go": ["-fno-escape-analysis"],
+    "fold.go": ["-fno-fold"],
+    "consteval.go": ["-fno-const-eval"],
+}
+
+# Cantidad de ejecuciones por variante (se reporta la mejor)
+runs = 5
+
+def build(go_file, flags, name):
+    asm_file = os.path.join(bench_out_dir, name + ".s")
+    bin_file = os.path.join(bench_out_dir, name)
+    with open(asm_file, "w") as out:
+        result = subprocess.run([f"./{executable}", go_file, "-s"] + flags, stdout=out, stderr=subprocess.PIPE, text=True)
+    if result.returncode != 0:
+        print(f"❌ Error compilando {go_file} {' '.join(flags)}: {result.stderr}")
+        return None
+    result = subprocess.run(["gcc", "-no-pie", "-o", bin_file, asm_file], stderr=subprocess.PIPE, text=True)
+    if result.returncode != 0:
+        print(f"❌ Error ensamblando {asm_file}: {result.stderr}")
+        return None
+    return bin_file
+
+# Mejor tiempo, salida y memoria máxima (RSS, en KB) de un ejecutable
+def measure(bin_file):
+    best = None
+    output = None
+    peak = 0
+    for _ in range(runs):
+        start = time.perf_counter()
+        proc = subprocess.Popen([bin_file], stdout=subprocess.PIPE, text=True)
+        output = proc.stdout.read()
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        elapsed = time.perf_counter() - start
+        peak = max(peak, usage.ru_maxrss)
+        if best is None or elapsed < best:
+            best = elapsed
+    return best, output, peak
+
+print("Compilando el compilador de Go...")
+result = subprocess.run(["g++", "-O2", "-o", executable] + source_files + ["-std=c++17"])
+if result.returncode != 0:
+    print("Error de compilación del compilador.")
+    sys.exit(1)
+
+if not os.path.exists(bench_out_dir):
+    os.makedirs(bench_out_dir)
+
+selected = sys.argv[1:]
+bench_files = sorted(f for f in os.listdir(benchmarks_dir) if f.endswith(".go"))
+if selected:
+    bench_files = [f for f in bench_files if f in selected]
+
+print("\n" + "="*80)
+print(f"{'Benchmark':<24}{'Referencia':>12}{'Optimizado':>12}{'Speedup':>10}{'RSS ref':>11}{'RSS opt':>11}")
+print("="*80)
+
+failures = 0
+for bench_file in bench_files:
+    go_file = os.path.join(benchmarks_dir, bench_file)
+    name = bench_file.replace(".go", "")
+    base_flags = baselines.get(bench_file, ["-O0"])
+
+    base_bin = build(go_file, base_flags, name + "_ref")
+    opt_bin = build(go_file, [], name + "_opt")
+    if not base_bin or not opt_bin:
+        failures += 1
+        continue
+
+    base_time, base_out, base_rss = measure(base_bin)
+    opt_time, opt_out, opt_rss = measure(opt_bin)
+    if base_out != opt_out:
+        print(f"❌ {bench_file}: la salida optimizada difiere de la referencia")
+        failures += 1
+        continue
+
+    print(f"{bench_file:<24}{base_time*1000:>10.1f}ms{opt_time*1000:>10.1f}ms{base_time/opt_time:>9.2f}x"
+          f"{base_rss/1024:>9.1f}MB{opt_rss/1024:>9.1f}MB")
+
+print("="*80)
+print(f"Referencia: opciones de 'baselines' (por defecto -O0)")
+
+if os.path.exists(executable):
+    os.remove(executable)
+
+sys.exit(1 if failures else 0)
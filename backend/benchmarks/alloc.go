@@ -0,0 +1,16 @@
+package main
+
+import "fmt"
+
+func main() {
+	letras := "abcdefghijklmnopqrstuvwxyz"
+	total := 0
+	for i := 0; i < 2000000; i++ {
+		a := letras[i%26:]
+		b := letras[:i%13]
+		s := a + "-" + b
+		t := b + s
+		total += len(s) + len(t)
+	}
+	fmt.Println(total)
+}
@@ -0,0 +1,19 @@
+package main
+
+import "fmt"
+
+func repetir(s string, veces int) string {
+	r := ""
+	for i := 0; i < veces; i++ {
+		r += s
+	}
+	return r
+}
+
+func main() {
+	total := 0
+	for k := 0; k < 4; k++ {
+		total += len(repetir("xyz", 4000 + k))
+	}
+	fmt.Println(total)
+}
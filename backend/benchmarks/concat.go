@@ -0,0 +1,20 @@
+package main
+
+import "fmt"
+
+func main() {
+	a := "alfa"
+	b := "beta"
+	c := "gamma"
+	d := "delta"
+	total := 0
+	for i := 0; i < 1000000; i++ {
+		x := a
+		if i%2 == 0 {
+			x = b
+		}
+		s := x + "," + b + "," + c + "," + d + "," + x + "," + a + ";"
+		total += len(s)
+	}
+	fmt.Println(total)
+}
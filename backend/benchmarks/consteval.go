@@ -0,0 +1,34 @@
+package main
+
+import "fmt"
+
+func fib(n int) int {
+	if n < 2 {
+		return n
+	}
+	return fib(n-1) + fib(n-2)
+}
+
+func primos(n int) int {
+	c := 0
+	for k := 2; k <= n; k++ {
+		primo := true
+		for d := 2; d*d <= k; d++ {
+			if k%d == 0 {
+				primo = false
+			}
+		}
+		if primo {
+			c++
+		}
+	}
+	return c
+}
+
+func main() {
+	total := 0
+	for i := 0; i < 500; i++ {
+		total = total + fib(25) + primos(500) + i
+	}
+	fmt.Println(total)
+}
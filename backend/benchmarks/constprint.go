@@ -0,0 +1,10 @@
+package main
+
+import "fmt"
+
+func main() {
+	for i := 0; i < 1000000; i++ {
+		fmt.Println("fila", 12345, true, "constante")
+		fmt.Println(-1, false)
+	}
+}
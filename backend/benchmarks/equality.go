@@ -0,0 +1,30 @@
+package main
+
+import "fmt"
+
+func main() {
+	base := "la ciguena tocaba el saxofon detras del palenque de paja"
+	largo := base + base + base + base + base + base + base + base
+	copia := largo
+	otro := largo + "!"
+	corto := "GET"
+	metodo := "POST"
+	iguales := 0
+	for i := 0; i < 3000000; i++ {
+		if i%3 == 0 {
+			metodo = corto
+		} else {
+			metodo = "POST"
+		}
+		if metodo == "GET" {
+			iguales++
+		}
+		if largo == copia {
+			iguales++
+		}
+		if largo != otro {
+			iguales++
+		}
+	}
+	fmt.Println(iguales)
+}
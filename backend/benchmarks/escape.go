@@ -0,0 +1,26 @@
+package main
+
+import "fmt"
+
+func clave(prefijo string, n int) int {
+	d := "0123456789"
+	k := prefijo + d[n%10:n%10+1] + "-" + d[n/10%10:n/10%10+1]
+	if k == "id:3-7" {
+		return 1000
+	}
+	return len(k)
+}
+
+func main() {
+	letras := "abcdefghijklmnopqrstuvwxyz"
+	total := 0
+	iguales := 0
+	for i := 0; i < 2000000; i++ {
+		s := letras[i%26:] + letras[:i%20]
+		if s+"!" == letras+"!" {
+			iguales++
+		}
+		total += len(s) + clave("id:", i)
+	}
+	fmt.Println(total, iguales)
+}
@@ -0,0 +1,32 @@
+package main
+
+import "fmt"
+
+func escalar(x int, factor int, corrimiento int) int {
+	return x*factor + corrimiento
+}
+
+func main() {
+	modo := "acumular"
+	factor := 3
+	corrimiento := 2 * 8
+	depurar := false
+	prefijo := "valor:"
+	limite := 1000 * 1000 * 1000
+	total := 0
+	for i := 0; i < 50000000; i++ {
+		v := escalar(i, factor, corrimiento) - len(prefijo)
+		if modo == "acumular" {
+			total = total + v
+		} else {
+			total = total - v
+		}
+		if depurar || total < 0 {
+			fmt.Println(prefijo, total)
+		}
+		if total > limite {
+			total = total - limite
+		}
+	}
+	fmt.Println(total)
+}
@@ -0,0 +1,15 @@
+package main
+
+import "fmt"
+
+func main() {
+	letras := "abcdefghijklmnopqrstuvwxyz"
+	total := 0
+	ultimo := ""
+	for i := 0; i < 1500000; i++ {
+		s := letras[i%26:] + letras[:i%20]
+		ultimo = s + "-" + s
+		total += len(ultimo)
+	}
+	fmt.Println(total, ultimo)
+}
@@ -0,0 +1,23 @@
+package main
+
+import "fmt"
+
+func max(a int, b int) int {
+	if a > b {
+		return a
+	}
+	return b
+}
+
+func cuadrado(x int) int {
+	return x * x
+}
+
+func main() {
+	total := 0
+	for i := 0; i < 30000000; i++ {
+		m := max(i%1000, 500)
+		total = total + cuadrado(m)%7
+	}
+	fmt.Println(total)
+}
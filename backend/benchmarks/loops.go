@@ -0,0 +1,21 @@
+package main
+
+import "fmt"
+
+type Config struct {
+	factor int
+	limit  int
+}
+
+func main() {
+	s := "benchmark de bucles invariantes"
+	c := Config{3, 40000}
+	k := 7
+	total := 0
+	for j := 0; j < c.limit; j++ {
+		for i := 0; i < len(s)*100; i++ {
+			total = total + i*k + c.factor*c.limit + j*2
+		}
+	}
+	fmt.Println(total)
+}
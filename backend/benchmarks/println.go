@@ -0,0 +1,11 @@
+package main
+
+import "fmt"
+
+func main() {
+	suma := 0
+	for i := 0; i < 1000000; i++ {
+		suma += i
+		fmt.Println(i, suma, i%2 == 0)
+	}
+}
@@ -0,0 +1,33 @@
+package main
+
+import "fmt"
+
+func main() {
+	a := "el veloz murcielago hindu comia feliz cardillo y kiwi"
+	for i := 0; i < 5; i++ {
+		a += a
+	}
+	b := a + "; la ciguena tocaba el saxofon detras del palenque de paja"
+
+	total := 0
+	t := a
+	for i := 0; i < 2000000; i++ {
+		if i%2 == 0 {
+			t = a
+		} else {
+			t = b
+		}
+		total += len(t)
+	}
+
+	iguales := 0
+	for i := 0; i < 200000; i++ {
+		c := t + "!"
+		if c != b {
+			iguales++
+		}
+		total += len(c)
+	}
+	fmt.Println(total)
+	fmt.Println(iguales)
+}
@@ -0,0 +1,20 @@
+package main
+
+import "fmt"
+
+type Bloque struct {
+	c0 int
+}
+
+func main() {
+	total := 0
+	var b Bloque
+	for i := 0; i < 100000000; i++ {
+		var a Bloque
+		a.c0 = i
+		a.c0 += i % 7
+		b = a
+		total = total + b.c0 % 3 + b.c0
+	}
+	fmt.Println(total)
+}
@@ -0,0 +1,35 @@
+package main
+
+import "fmt"
+
+type Bloque struct {
+	c0 int
+	c1 int
+	c2 int
+	c3 int
+	c4 int
+	c5 int
+	c6 int
+	c7 int
+	c8 int
+	c9 int
+	c10 int
+	c11 int
+	c12 int
+	c13 int
+	c14 int
+	c15 int
+}
+
+func main() {
+	total := 0
+	var b Bloque
+	for i := 0; i < 20000000; i++ {
+		var a Bloque
+		a.c0 = i
+		a.c15 += i % 7
+		b = a
+		total = total + b.c0 % 3 + b.c15
+	}
+	fmt.Println(total)
+}
@@ -0,0 +1,23 @@
+package main
+
+import "fmt"
+
+type Bloque struct {
+	c0 int
+	c1 int
+	c2 int
+	c3 int
+}
+
+func main() {
+	total := 0
+	var b Bloque
+	for i := 0; i < 50000000; i++ {
+		var a Bloque
+		a.c0 = i
+		a.c3 += i % 7
+		b = a
+		total = total + b.c0 % 3 + b.c3
+	}
+	fmt.Println(total)
+}
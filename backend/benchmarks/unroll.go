@@ -0,0 +1,19 @@
+package main
+
+import "fmt"
+
+func main() {
+	n := 20000
+	total := 0
+	for j := 0; j < n; j++ {
+		acc := j
+		for i := 0; i < n; i++ {
+			acc += i
+		}
+		for k := 0; k < 8; k++ {
+			acc = acc + k
+		}
+		total = total + acc%1000
+	}
+	fmt.Println(total)
+}
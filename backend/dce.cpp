@@ -0,0 +1,141 @@
+#include "dce.h"
+#include <set>
+#include <map>
+#include "ast_utils.h"
+
+using namespace std;
+
+DeadCodeEliminator::DeadCodeEliminator(const CompilerOptions& opts)
+    : options(opts), removed_nodes(0), folded_branches(0) {}
+
+// Valor de una condición conocida en compilación; false si no es constante
+static bool constant_condition(Exp* cond, bool& value) {
+    if (auto b = dynamic_cast<BoolExp*>(cond)) {
+        value = b->value;
+        return true;
+    }
+    if (auto u = dynamic_cast<UnaryExp*>(cond)) {
+        if (u->op == NOT_OP && constant_condition(u->exp, value)) {
+            value = !value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool stmt_always_returns(Stmt* stmt) {
+    if (dynamic_cast<ReturnStmt*>(stmt)) return true;
+    if (auto is = dynamic_cast<IfStmt*>(stmt)) {
+        return always_returns(is->thenBlock) && always_returns(is->elseBlock);
+    }
+    if (auto bs = dynamic_cast<BlockStmt*>(stmt)) return always_returns(bs->block);
+    return false;
+}
+
+// Devuelve la sentencia que reemplaza a 'stmt' (ella misma, otra, o nullptr si
+// desaparece). La sentencia original queda liberada si se reemplaza.
+Stmt* DeadCodeEliminator::prune_stmt(Stmt* stmt) {
+    if (auto is = dynamic_cast<IfStmt*>(stmt)) {
+        bool value;
+        if (constant_condition(is->condition, value)) {
+            // La rama elegida conserva su propio alcance dentro de un BlockStmt
+            Block*& taken = value ? is->thenBlock : is->elseBlock;
+            Block*& dropped = value ? is->elseBlock : is->thenBlock;
+            removed_nodes += 1 + count_nodes(is->condition) + count_nodes(dropped);
+            Stmt* replacement = taken ? new BlockStmt(taken) : nullptr;
+            taken = nullptr;
+            delete is;
+            folded_branches++;
+            return replacement ? prune_stmt(replacement) : nullptr;
+        }
+        prune_block(is->thenBlock);
+        prune_block(is->elseBlock);
+    } else if (auto fs = dynamic_cast<ForStmt*>(stmt)) {
+        bool value;
+        if (constant_condition(fs->condition, value) && !value) {
+            // El cuerpo nunca se ejecuta; el init sí, y en su propio alcance
+            removed_nodes += count_nodes(fs) - count_nodes(fs->init);
+            Stmt* replacement = fs->init ? new BlockStmt(new Block({fs->init})) : nullptr;
+            fs->init = nullptr;
+            delete fs;
+            folded_branches++;
+            return replacement;
+        }
+        prune_block(fs->body);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(stmt)) {
+        prune_block(bs->block);
+    }
+    return stmt;
+}
+
+void DeadCodeEliminator::prune_block(Block* block) {
+    if (!block) return;
+    auto& stmts = block->statements;
+    for (auto it = stmts.begin(); it != stmts.end();) {
+        Stmt* pruned = prune_stmt(*it);
+        if (!pruned) {
+            it = stmts.erase(it);
+            continue;
+        }
+        *it = pruned;
+        ++it;
+        if (stmt_always_returns(pruned)) {
+            for (auto dead = it; dead != stmts.end(); ++dead) {
+                removed_nodes += count_nodes(*dead);
+                delete *dead;
+            }
+            stmts.erase(it, stmts.end());
+            break;
+        }
+    }
+}
+
+void DeadCodeEliminator::run(Program* program) {
+    if (!options.dce) return;
+
+    map<string, FuncDecl*> functions;
+    for (auto func : program->functions) functions[func->name] = func;
+
+    // Primero se podan los cuerpos: una llamada dentro de una rama muerta no
+    // debe mantener viva a la función llamada
+    for (auto func : program->functions) prune_block(func->body);
+
+    if (functions.count("main")) {
+        // Las funciones llamadas al inicializar las globales corren antes que main
+        set<string> reachable = {"main"};
+        for (auto decl : program->globalVars) {
+            for (auto value : decl->values) collect_called_functions(value, reachable);
+        }
+        vector<string> pending;
+        for (auto& name : reachable) {
+            if (functions.count(name)) pending.push_back(name);
+        }
+        while (!pending.empty()) {
+            FuncDecl* func = functions[pending.back()];
+            pending.pop_back();
+            set<string> callees;
+            collect_called_functions(func->body, callees);
+            for (auto& name : callees) {
+                if (functions.count(name) && reachable.insert(name).second) pending.push_back(name);
+            }
+        }
+
+        for (auto it = program->functions.begin(); it != program->functions.end();) {
+            if (reachable.count((*it)->name)) {
+                ++it;
+                continue;
+            }
+            removed_functions.push_back((*it)->name);
+            removed_nodes += count_nodes((*it)->body);
+            delete *it;
+            it = program->functions.erase(it);
+        }
+    }
+}
+
+void DeadCodeEliminator::print_stats(ostream& out) {
+    out << "=== CÓDIGO MUERTO ===" << endl;
+    for (auto& name : removed_functions) out << "  función eliminada: " << name << endl;
+    out << "Funciones eliminadas: " << removed_functions.size() << ", ramas constantes resueltas: "
+        << folded_branches << ", nodos del AST eliminados: " << removed_nodes << endl;
+}
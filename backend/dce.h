@@ -0,0 +1,36 @@
+#ifndef DCE_H
+#define DCE_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "exp.h"
+#include "options.h"
+
+using namespace std;
+
+// Eliminación de código muerto sobre el programa completo:
+//  - Funciones que no se alcanzan desde main ni desde los inicializadores de las
+//    globales en el grafo de llamadas (si no hay main, el programa se deja intacto).
+//  - Sentencias posteriores a un return incondicional dentro de un bloque.
+//  - Ramas de if con condición constante (true, false, !true, !false) y bucles
+//    for cuya condición es false.
+// Corre después del inlining, que deja sin llamadas a muchas funciones pequeñas.
+class DeadCodeEliminator {
+private:
+    const CompilerOptions& options;
+
+    void prune_block(Block* block);
+    Stmt* prune_stmt(Stmt* stmt);
+
+public:
+    vector<string> removed_functions;
+    int removed_nodes;
+    int folded_branches;
+
+    DeadCodeEliminator(const CompilerOptions& opts);
+    void run(Program* program);
+    void print_stats(ostream& out);
+};
+
+#endif
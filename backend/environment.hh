@@ -13,24 +13,33 @@ struct VarInfo {
     int offset;
     ImpVType type;
     string struct_name;
+    bool builder = false; // String acumulador: su capacidad está en offset + 16
 };
 
 struct FieldInfo {
     string type_name;
     ImpVType type;
     int size;
+    int align;
+    int offset;
+    string struct_name; // Si el campo es un struct anidado
 };
 
 struct StructInfo {
     string name;
     std::unordered_map<string, FieldInfo> fields; 
     std::unordered_map<string, int> offsets;      
+    vector<string> field_order; // Campos en orden de declaración (el de los literales)
     int size = 0;
+    int align = 1;
 };
 
 struct FuncInfo {
     int stack_size; 
     ImpVType return_type;
+    string return_struct;         // Struct devuelto ("" si es escalar)
+    vector<ImpVType> param_types; // Tipo de cada parámetro (NOTYPE si es un struct)
+    vector<string> param_structs; // Struct de cada parámetro ("" si es escalar)
 };
 
 class Environment {
@@ -71,12 +80,13 @@ public:
         return false;
     }
 
-    void add_var(const string& var, int offset, ImpVType type, const string& struct_name = "") {
+    void add_var(const string& var, int offset, ImpVType type, const string& struct_name = "",
+                 bool builder = false) {
         if (var_levels.empty()) {
             cout << "Environment sin niveles: no se pueden agregar variables" << endl;
             exit(1);
         }
-        var_levels.back()[var] = {offset, type, struct_name};
+        var_levels.back()[var] = {offset, type, struct_name, builder};
     }
     
     bool check(const string& x) {
@@ -92,6 +102,16 @@ public:
         return var_levels[idx][x];
     }
 
+    // Todas las variables de los niveles abiertos, incluidas las tapadas por otra del
+    // mismo nombre (siguen vivas hasta que se cierra el bloque interior)
+    vector<VarInfo> visible_vars() {
+        vector<VarInfo> vars;
+        for (auto& level : var_levels) {
+            for (auto& kv : level) vars.push_back(kv.second);
+        }
+        return vars;
+    }
+
     void add_function(const string& name, const FuncInfo& info) {
         functions[name] = info;
     }
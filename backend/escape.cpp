@@ -0,0 +1,263 @@
+#include "escape.h"
+#include "ast_utils.h"
+
+using namespace std;
+
+// Buffers del marco por función como máximo (los temporales, a lo sumo la mitad);
+// las demás concatenaciones se reservan en el heap
+static const int MAX_STACK_BUFFERS = 8;
+static const int MAX_TEMP_BUFFERS = MAX_STACK_BUFFERS / 2;
+
+EscapeAnalyzer::EscapeAnalyzer(const CompilerOptions& opts) : options(opts) {}
+
+void EscapeAnalyzer::find_recursive() {
+    map<string, set<string>> call_graph;
+    for (auto& entry : functions) {
+        set<string> names;
+        collect_called_functions(entry.second->body, names);
+        for (auto& name : names) {
+            if (functions.count(name)) call_graph[entry.first].insert(name);
+        }
+    }
+    for (auto& entry : call_graph) {
+        set<string> seen;
+        vector<string> pending(entry.second.begin(), entry.second.end());
+        while (!pending.empty()) {
+            string name = pending.back();
+            pending.pop_back();
+            if (name == entry.first) {
+                recursive.insert(name);
+                break;
+            }
+            if (!seen.insert(name).second) continue;
+            for (auto& callee : call_graph[name]) pending.push_back(callee);
+        }
+    }
+}
+
+static bool is_string_type(Type* t) {
+    auto bt = dynamic_cast<BasicType*>(t);
+    return bt && bt->typeName == "string";
+}
+
+// Tipado aproximado: basta con no dejar afuera ningún string (un falso positivo solo
+// gasta un buffer, que el generador no usa si la expresión no es un string)
+bool EscapeAnalyzer::is_string(Exp* e) {
+    if (dynamic_cast<StringExp*>(e) || dynamic_cast<SliceExp*>(e)) return true;
+    if (auto bin = dynamic_cast<BinaryExp*>(e)) return bin->op == PLUS_OP && is_string(bin->left);
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) return string_vars.count(id->name) > 0;
+    if (auto fa = dynamic_cast<FieldAccessExp*>(e)) return string_fields.count(fa->field) > 0;
+    if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        auto found = functions.find(call->funcName);
+        return found != functions.end() && is_string_type(found->second->returnType);
+    }
+    return false;
+}
+
+// Concatenación que reserva: una cadena de solo literales se junta en compilación
+static bool allocating_concat(Exp* e) {
+    auto bin = dynamic_cast<BinaryExp*>(e);
+    if (!bin || bin->op != PLUS_OP) return !dynamic_cast<StringExp*>(e);
+    return allocating_concat(bin->left) || allocating_concat(bin->right);
+}
+
+// 'consumed' indica si el contexto solo lee el valor de 'e'. Las concatenaciones
+// consumidas se anotan en 'temps'; dentro de una cadena a + b + c solo cuenta la raíz,
+// que es la que reserva
+void EscapeAnalyzer::walk_exp(Exp* e, bool consumed, vector<Exp*>& temps, bool in_concat) {
+    if (!e) return;
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        if (!consumed) escaping.insert(id->name);
+    } else if (auto bin = dynamic_cast<BinaryExp*>(e)) {
+        bool concat = bin->op == PLUS_OP && is_string(bin);
+        if (concat && consumed && !in_concat && allocating_concat(bin)) temps.push_back(bin);
+        walk_exp(bin->left, true, temps, concat);
+        walk_exp(bin->right, true, temps, concat);
+    } else if (auto un = dynamic_cast<UnaryExp*>(e)) {
+        walk_exp(un->exp, true, temps);
+    } else if (auto idx = dynamic_cast<IndexExp*>(e)) {
+        walk_exp(idx->array, true, temps);
+        walk_exp(idx->index, true, temps);
+    } else if (auto slice = dynamic_cast<SliceExp*>(e)) {
+        // La vista comparte los bytes: escapa si escapa ella
+        walk_exp(slice->array, consumed, temps);
+        walk_exp(slice->start, true, temps);
+        walk_exp(slice->end, true, temps);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        walk_exp(fa->object, true, temps);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        bool builtin = call->funcName == "len" || call->funcName == "fmt.Println";
+        auto summary = param_escapes.find(call->funcName);
+        size_t i = 0;
+        for (auto arg : call->args) {
+            bool arg_consumed = builtin;
+            if (summary != param_escapes.end() && i < summary->second.size()) arg_consumed = !summary->second[i];
+            walk_exp(arg, arg_consumed, temps);
+            i++;
+        }
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        for (auto value : lit->values) walk_exp(value, false, temps);
+    }
+}
+
+void EscapeAnalyzer::walk_stmt(Stmt* s) {
+    if (!s) return;
+    vector<Exp*> temps;
+    // x := a + b: la concatenación queda en la pila si x no escapa
+    auto declare = [&](const string& name, Exp* value) {
+        auto bin = dynamic_cast<BinaryExp*>(value);
+        if (bin && bin->op == PLUS_OP && is_string(bin)) {
+            if (allocating_concat(bin)) var_candidates.push_back({bin, name});
+            walk_exp(bin->left, true, temps, true);
+            walk_exp(bin->right, true, temps, true);
+        } else {
+            walk_exp(value, false, temps);
+        }
+    };
+
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        walk_exp(es->expression, true, temps);
+    } else if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        // s += e copia e; s = e guarda e en otra variable, un campo o una global
+        walk_exp(as->rhs, as->op != ASSIGN_OP, temps);
+        if (as->op != ASSIGN_OP) walk_exp(as->lhs, true, temps);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        auto value = sv->values.begin();
+        for (auto& name : sv->identifiers) {
+            if (value == sv->values.end()) break;
+            declare(name, *value);
+            if (is_string(*value)) string_vars.insert(name);
+            ++value;
+        }
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        auto value = vd->values.begin();
+        for (auto& name : vd->names) {
+            if (value != vd->values.end()) declare(name, *value++);
+            if (is_string_type(vd->type)) string_vars.insert(name);
+        }
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        walk_exp(is->condition, true, temps);
+        stmt_temps.push_back(temps);
+        walk_block(is->thenBlock);
+        walk_block(is->elseBlock);
+        return;
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        walk_stmt(fs->init);
+        walk_exp(fs->condition, true, temps);
+        stmt_temps.push_back(temps);
+        walk_stmt(fs->post);
+        walk_block(fs->body);
+        return;
+    } else if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        auto call = dynamic_cast<FunctionCallExp*>(rs->expression);
+        if (call && functions.count(call->funcName)) {
+            for (auto arg : call->args) walk_exp(arg, false, temps);
+        } else {
+            walk_exp(rs->expression, false, temps);
+        }
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        walk_block(bs->block);
+        return;
+    }
+    stmt_temps.push_back(temps);
+}
+
+void EscapeAnalyzer::walk_block(Block* b) {
+    if (!b) return;
+    for (auto s : b->statements) walk_stmt(s);
+}
+
+void EscapeAnalyzer::analyze(FuncDecl* func) {
+    string_vars = global_strings;
+    escaping = globals;
+    var_candidates.clear();
+    stmt_temps.clear();
+    for (auto& param : func->params) {
+        if (is_string_type(param.second)) string_vars.insert(param.first);
+    }
+    walk_block(func->body);
+}
+
+void EscapeAnalyzer::record(FuncDecl* func) {
+    if (recursive.count(func->name)) return;
+    int temps = 0;
+    for (auto& group : stmt_temps) {
+        for (int i = 0; i < (int)group.size() && i < MAX_TEMP_BUFFERS; i++) temp_buffers[group[i]] = i;
+        temps = max(temps, min((int)group.size(), MAX_TEMP_BUFFERS));
+    }
+    temp_buffer_count[func->name] = temps;
+    int vars = 0;
+    for (auto& candidate : var_candidates) {
+        if (escaping.count(candidate.second) || temps + vars >= MAX_STACK_BUFFERS) continue;
+        var_buffers.insert(candidate.first);
+        vars++;
+    }
+    var_buffer_count[func->name] = vars;
+    set<string>& locals = local_vars[func->name];
+    for (auto& name : string_vars) {
+        if (!escaping.count(name)) locals.insert(name);
+    }
+}
+
+void EscapeAnalyzer::run(Program* program) {
+    if (!options.escape_analysis || options.stack_buffer == 0) return;
+    for (auto type : program->types) {
+        for (auto& field : type->structType->fields) {
+            if (is_string_type(field.second)) string_fields.insert(field.first);
+        }
+    }
+    for (auto decl : program->globalVars) {
+        globals.insert(decl->names.begin(), decl->names.end());
+        if (is_string_type(decl->type)) global_strings.insert(decl->names.begin(), decl->names.end());
+    }
+    for (auto func : program->functions) {
+        functions[func->name] = func;
+        param_escapes[func->name] = vector<bool>(func->params.size(), false);
+    }
+    find_recursive();
+
+    // Se parte de que ningún parámetro escapa y se marcan los que sí hasta que nada cambie
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto func : program->functions) {
+            analyze(func);
+            size_t i = 0;
+            for (auto& param : func->params) {
+                if (escaping.count(param.first) && !param_escapes[func->name][i]) {
+                    param_escapes[func->name][i] = true;
+                    changed = true;
+                }
+                i++;
+            }
+        }
+    }
+    for (auto func : program->functions) {
+        analyze(func);
+        record(func);
+    }
+}
+
+void EscapeAnalyzer::print_stats(ostream& out) {
+    out << "=== ANÁLISIS DE ESCAPE ===" << endl;
+    for (auto& entry : functions) {
+        const string& name = entry.first;
+        out << "  " << name << ": ";
+        if (recursive.count(name)) {
+            out << "recursiva, sin buffers en la pila";
+        } else {
+            out << temp_buffer_count[name] << " buffers temporales y " << var_buffer_count[name]
+                << " de variables";
+        }
+        string params;
+        size_t i = 0;
+        for (auto& param : entry.second->params) {
+            if (is_string_type(param.second) && !param_escapes[name][i]) {
+                params += (params.empty() ? "" : ", ") + param.first;
+            }
+            i++;
+        }
+        if (!params.empty()) out << "; parámetros que no escapan: " << params;
+        out << endl;
+    }
+}
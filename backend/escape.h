@@ -0,0 +1,78 @@
+#ifndef ESCAPE_H
+#define ESCAPE_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "exp.h"
+#include "options.h"
+
+using namespace std;
+
+// Análisis de escape de strings sobre el AST ya optimizado. Un valor escapa si puede
+// seguir en uso después de la sentencia (o del alcance de la variable) que lo
+// produjo: si se devuelve, se asigna (a otra variable, a un campo o a una global), se
+// guarda en un struct literal, se pasa a un parámetro que escapa o se toma una vista
+// s[a:b] que escapa. fmt.Println, len, las comparaciones, s[i], las concatenaciones
+// (que copian) y s += e solo lo consumen.
+//
+// Una concatenación cuyo resultado no escapa se escribe en un buffer de
+// -fstack-buffer=N bytes del marco en lugar de pedirlo a _go_alloc (si no entra se
+// reserva como siempre):
+//  - Si solo se usa dentro de su sentencia, en el área de temporales del marco, que
+//    comparten todas las sentencias de la función.
+//  - Si inicializa una variable que no escapa (s := a + b), en un buffer que vive en
+//    el alcance de la variable.
+// Los acumuladores (s += e en un bucle) que no escapan empiezan con un buffer del
+// marco como capacidad.
+//
+// De cada función se resume qué parámetros escapan, iterando hasta un punto fijo, así
+// que un argumento también puede quedar en el marco del llamador. Los argumentos de
+// 'return f(...)' escapan porque la llamada de cola reutiliza o descarta el marco, y
+// las funciones recursivas no llevan buffers para no agrandar cada nivel de la pila.
+class EscapeAnalyzer {
+private:
+    const CompilerOptions& options;
+    map<string, FuncDecl*> functions;
+    set<string> recursive;
+    // Por función, si su parámetro i escapa
+    map<string, vector<bool>> param_escapes;
+    // Campos string de algún struct, para reconocer strings sin tipar todo el programa
+    set<string> string_fields;
+    // Las globales (y sus valores) siempre escapan
+    set<string> globals;
+    set<string> global_strings;
+    map<string, int> var_buffer_count;
+
+    // Estado de la función que se analiza
+    set<string> string_vars;
+    set<string> escaping;
+    vector<pair<Exp*, string>> var_candidates;
+    vector<vector<Exp*>> stmt_temps;
+
+    void find_recursive();
+    bool is_string(Exp* e);
+    void walk_exp(Exp* e, bool consumed, vector<Exp*>& temps, bool in_concat = false);
+    void walk_stmt(Stmt* s);
+    void walk_block(Block* b);
+    void analyze(FuncDecl* func);
+    void record(FuncDecl* func);
+
+public:
+    // Concatenaciones que solo se usan en su sentencia -> índice de su buffer temporal
+    map<Exp*, int> temp_buffers;
+    // Buffers temporales por función (el máximo que usa una sentencia)
+    map<string, int> temp_buffer_count;
+    // Concatenaciones que inicializan una variable que no escapa
+    set<Exp*> var_buffers;
+    // Variables locales de cada función cuyos valores no escapan
+    map<string, set<string>> local_vars;
+
+    EscapeAnalyzer(const CompilerOptions& opts);
+    void run(Program* program);
+    void print_stats(ostream& out);
+};
+
+#endif
@@ -0,0 +1,406 @@
+#include "evaluator.h"
+#include "ast_utils.h"
+
+using namespace std;
+
+bool apply_unary(UnaryOp op, ConstValue& value) {
+    if (op == NOT_OP) {
+        value.number = !value.number;
+        return value.type == TBOOL;
+    }
+    if (op == UMINUS_OP) value.number = (long long)(0ULL - (unsigned long long)value.number);
+    return value.type == TINT;
+}
+
+bool apply_binary(BinaryOp op, const ConstValue& l, const ConstValue& r, ConstValue& out) {
+    if (l.type != r.type) return false;
+    if (l.type == TSTRING) {
+        if (op == PLUS_OP) out = {TSTRING, 0, l.text + r.text};
+        else if (op == EQ_OP || op == NE_OP) out = {TBOOL, (l.text == r.text) == (op == EQ_OP), ""};
+        else return false;
+        return true;
+    }
+    unsigned long long a = l.number, b = r.number;
+    switch (op) {
+        case PLUS_OP: out = {TINT, (long long)(a + b), ""}; break;
+        case MINUS_OP: out = {TINT, (long long)(a - b), ""}; break;
+        case MUL_OP: out = {TINT, (long long)(a * b), ""}; break;
+        case DIV_OP:
+        case MOD_OP:
+            if (r.number == 0) return false;
+            // x / -1 es -x también para el mínimo, que se desborda en sí mismo
+            if (r.number == -1) out = {TINT, op == DIV_OP ? (long long)(0ULL - a) : 0, ""};
+            else out = {TINT, op == DIV_OP ? l.number / r.number : l.number % r.number, ""};
+            break;
+        case LT_OP: out = {TBOOL, l.number < r.number, ""}; break;
+        case LE_OP: out = {TBOOL, l.number <= r.number, ""}; break;
+        case GT_OP: out = {TBOOL, l.number > r.number, ""}; break;
+        case GE_OP: out = {TBOOL, l.number >= r.number, ""}; break;
+        case EQ_OP: out = {TBOOL, l.number == r.number, ""}; return true;
+        case NE_OP: out = {TBOOL, l.number != r.number, ""}; return true;
+        case AND_OP: out = {TBOOL, l.number && r.number, ""}; return l.type == TBOOL;
+        case OR_OP: out = {TBOOL, l.number || r.number, ""}; return l.type == TBOOL;
+    }
+    return l.type == TINT;
+}
+
+bool apply_index(const ConstValue& str, const ConstValue& index, ConstValue& out) {
+    if (str.type != TSTRING || index.type != TINT) return false;
+    if (index.number < 0 || index.number >= (long long)str.text.size()) return false;
+    out = {TINT, (unsigned char)str.text[index.number], ""};
+    return true;
+}
+
+bool apply_slice(const ConstValue& str, const ConstValue* start, const ConstValue* end, ConstValue& out) {
+    if (str.type != TSTRING || (start && start->type != TINT) || (end && end->type != TINT)) return false;
+    long long from = start ? start->number : 0;
+    long long to = end ? end->number : (long long)str.text.size();
+    if (from < 0 || from > to || to > (long long)str.text.size()) return false;
+    out = {TSTRING, 0, str.text.substr(from, to - from)};
+    return true;
+}
+
+bool eval_constant(Exp* e, const map<string, Exp*>& known, ConstValue& out) {
+    if (auto num = dynamic_cast<NumberExp*>(e)) {
+        out = {TINT, num->value, ""};
+        return true;
+    }
+    if (auto b = dynamic_cast<BoolExp*>(e)) {
+        out = {TBOOL, b->value, ""};
+        return true;
+    }
+    if (auto str = dynamic_cast<StringExp*>(e)) {
+        out = {TSTRING, 0, str->value};
+        return true;
+    }
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        auto found = known.find(id->name);
+        return found != known.end() && eval_constant(found->second, known, out);
+    }
+    if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return eval_constant(u->exp, known, out) && apply_unary(u->op, out);
+    }
+    if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        ConstValue arg;
+        if (call->funcName != "len" || call->args.size() != 1) return false;
+        if (!eval_constant(call->args.front(), known, arg) || arg.type != TSTRING) return false;
+        out = {TINT, (long long)arg.text.size(), ""};
+        return true;
+    }
+    if (auto idx = dynamic_cast<IndexExp*>(e)) {
+        ConstValue str, index;
+        return eval_constant(idx->array, known, str) && eval_constant(idx->index, known, index) &&
+               apply_index(str, index, out);
+    }
+    if (auto slice = dynamic_cast<SliceExp*>(e)) {
+        ConstValue str, start, end;
+        if (!eval_constant(slice->array, known, str)) return false;
+        if (slice->start && !eval_constant(slice->start, known, start)) return false;
+        if (slice->end && !eval_constant(slice->end, known, end)) return false;
+        return apply_slice(str, slice->start ? &start : nullptr, slice->end ? &end : nullptr, out);
+    }
+    auto bin = dynamic_cast<BinaryExp*>(e);
+    ConstValue l, r;
+    if (!bin || !eval_constant(bin->left, known, l) || !eval_constant(bin->right, known, r)) return false;
+    return apply_binary(bin->op, l, r, out);
+}
+
+Exp* constant_exp(const ConstValue& value) {
+    if (value.type == TSTRING) return new StringExp(value.text);
+    if (value.type == TBOOL) return new BoolExp(value.number != 0);
+    return new NumberExp(value.number);
+}
+
+CallEvaluator::CallEvaluator(const CompilerOptions& opts)
+    : options(opts), memo_bytes(0), steps(0), depth(0), evaluated_count(0) {}
+
+static ImpVType basic_type(Type* t) {
+    auto bt = dynamic_cast<BasicType*>(t);
+    return bt ? ImpValue::get_basic_type(bt->typeName) : NOTYPE;
+}
+
+// Parámetros y resultado escalares, y ningún nombre que la función no declare
+static bool pure_candidate(FuncDecl* func) {
+    if (func->name == "main" || basic_type(func->returnType) == NOTYPE) return false;
+    set<string> declared;
+    for (auto& param : func->params) {
+        if (basic_type(param.second) == NOTYPE) return false;
+        declared.insert(param.first);
+    }
+    collect_declared_vars(func->body, declared);
+    set<string> used;
+    collect_modified_vars(func->body, used);
+    rewrite_block_exps(func->body, [&](Exp* e) -> Exp* {
+        if (auto id = dynamic_cast<IdentifierExp*>(e)) used.insert(id->name);
+        return nullptr;
+    });
+    for (auto& name : used) {
+        if (!declared.count(name)) return false;
+    }
+    return true;
+}
+
+void CallEvaluator::analyze(Program* program) {
+    if (!options.const_eval) return;
+    map<string, set<string>> callees;
+    for (auto func : program->functions) {
+        functions[func->name] = func;
+        collect_called_functions(func->body, callees[func->name]);
+        if (pure_candidate(func)) pure.insert(func->name);
+    }
+    // Se descartan las que llaman a algo impuro hasta que nada cambie
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = pure.begin(); it != pure.end();) {
+            bool calls_impure = false;
+            for (auto& name : callees[*it]) {
+                if (name != "len" && !pure.count(name)) calls_impure = true;
+            }
+            if (!calls_impure) {
+                ++it;
+                continue;
+            }
+            it = pure.erase(it);
+            changed = true;
+        }
+    }
+}
+
+static string memo_key(const string& name, const vector<ConstValue>& args) {
+    string key = name;
+    for (auto& arg : args) {
+        key += "|" + to_string(arg.type) + ":";
+        key += arg.type == TSTRING ? to_string(arg.text.size()) + ":" + arg.text : to_string(arg.number);
+    }
+    return key;
+}
+
+bool CallEvaluator::evaluate(FunctionCallExp* call, ConstValue& out) {
+    if (!options.const_eval || !pure.count(call->funcName)) return false;
+    vector<ConstValue> args;
+    for (auto arg : call->args) {
+        ConstValue value;
+        if (!eval_constant(arg, {}, value)) return false;
+        args.push_back(value);
+    }
+    // Un fracaso de primer nivel se repetiría igual en otro sitio de llamada
+    string key = memo_key(call->funcName, args);
+    if (failed.count(key)) return false;
+    steps = 0;
+    depth = 0;
+    if (!this->call(functions[call->funcName], args, out)) {
+        failed.insert(key);
+        return false;
+    }
+    evaluated_count++;
+    return true;
+}
+
+bool CallEvaluator::spend() {
+    return ++steps <= options.const_eval_steps;
+}
+
+// apply_binary con el límite de bytes: una concatenación que no entra no se arma
+bool CallEvaluator::binary(BinaryOp op, const ConstValue& l, const ConstValue& r, ConstValue& out) {
+    if (op == PLUS_OP && l.type == TSTRING && r.type == TSTRING &&
+        l.text.size() + r.text.size() > (size_t)options.const_eval_bytes) {
+        return false;
+    }
+    return apply_binary(op, l, r, out);
+}
+
+bool CallEvaluator::call(FuncDecl* func, const vector<ConstValue>& args, ConstValue& out) {
+    if (args.size() != func->params.size()) return false;
+    string key = memo_key(func->name, args);
+    auto found = memo.find(key);
+    if (found != memo.end()) {
+        out = found->second;
+        return true;
+    }
+    if (depth >= options.const_eval_depth) return false;
+
+    Frame frame(1);
+    size_t i = 0;
+    for (auto& param : func->params) {
+        if (basic_type(param.second) != args[i].type) return false;
+        frame.back()[param.first] = args[i++];
+    }
+    ConstValue result;
+    depth++;
+    Flow flow = exec_block(func->body, frame, result);
+    depth--;
+    if (flow != RETURN || result.type != basic_type(func->returnType)) return false;
+    size_t entry = key.size() + result.text.size();
+    if (memo_bytes + entry <= (size_t)options.const_eval_bytes) {
+        memo[key] = result;
+        memo_bytes += entry;
+    }
+    out = result;
+    return true;
+}
+
+ConstValue* CallEvaluator::lookup(Frame& frame, const string& name) {
+    for (auto scope = frame.rbegin(); scope != frame.rend(); ++scope) {
+        auto found = scope->find(name);
+        if (found != scope->end()) return &found->second;
+    }
+    return nullptr;
+}
+
+bool CallEvaluator::eval(Exp* e, Frame& frame, ConstValue& out) {
+    if (!spend()) return false;
+    if (dynamic_cast<NumberExp*>(e) || dynamic_cast<BoolExp*>(e) || dynamic_cast<StringExp*>(e)) {
+        return eval_constant(e, {}, out);
+    }
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        ConstValue* value = lookup(frame, id->name);
+        if (!value) return false;
+        out = *value;
+        return true;
+    }
+    if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        return eval(u->exp, frame, out) && apply_unary(u->op, out);
+    }
+    if (auto bin = dynamic_cast<BinaryExp*>(e)) {
+        ConstValue l, r;
+        if (!eval(bin->left, frame, l)) return false;
+        if (bin->op == AND_OP || bin->op == OR_OP) {
+            // Cortocircuito: el lado derecho solo se evalúa si el izquierdo no decide
+            if (l.type != TBOOL) return false;
+            if ((bin->op == AND_OP) != (l.number != 0)) {
+                out = l;
+                return true;
+            }
+            return eval(bin->right, frame, out) && out.type == TBOOL;
+        }
+        return eval(bin->right, frame, r) && binary(bin->op, l, r, out);
+    }
+    if (auto idx = dynamic_cast<IndexExp*>(e)) {
+        ConstValue str, index;
+        return eval(idx->array, frame, str) && eval(idx->index, frame, index) && apply_index(str, index, out);
+    }
+    if (auto slice = dynamic_cast<SliceExp*>(e)) {
+        ConstValue str, start, end;
+        if (!eval(slice->array, frame, str)) return false;
+        if (slice->start && !eval(slice->start, frame, start)) return false;
+        if (slice->end && !eval(slice->end, frame, end)) return false;
+        return apply_slice(str, slice->start ? &start : nullptr, slice->end ? &end : nullptr, out);
+    }
+    if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        vector<ConstValue> args;
+        for (auto arg : call->args) {
+            ConstValue value;
+            if (!eval(arg, frame, value)) return false;
+            args.push_back(value);
+        }
+        if (call->funcName == "len") {
+            if (args.size() != 1 || args[0].type != TSTRING) return false;
+            out = {TINT, (long long)args[0].text.size(), ""};
+            return true;
+        }
+        return pure.count(call->funcName) && this->call(functions[call->funcName], args, out);
+    }
+    return false;
+}
+
+// Operador que aplica cada asignación compuesta
+static BinaryOp assign_binary_op(AssignOp op) {
+    switch (op) {
+        case PLUS_ASSIGN_OP: return PLUS_OP;
+        case MINUS_ASSIGN_OP: return MINUS_OP;
+        case MUL_ASSIGN_OP: return MUL_OP;
+        case DIV_ASSIGN_OP: return DIV_OP;
+        default: return MOD_OP;
+    }
+}
+
+CallEvaluator::Flow CallEvaluator::exec(Stmt* s, Frame& frame, ConstValue& result) {
+    if (!spend()) return FAIL;
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        ConstValue ignored;
+        return eval(es->expression, frame, ignored) ? NEXT : FAIL;
+    }
+    if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        auto lhs = dynamic_cast<IdentifierExp*>(as->lhs);
+        ConstValue* var = lhs ? lookup(frame, lhs->name) : nullptr;
+        ConstValue value, updated;
+        if (!var || !eval(as->rhs, frame, value)) return FAIL;
+        if (as->op == ASSIGN_OP) updated = value;
+        else if (!binary(assign_binary_op(as->op), *var, value, updated)) return FAIL;
+        if (updated.type != var->type) return FAIL;
+        *var = updated;
+        return NEXT;
+    }
+    if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        // Primero todos los valores: en x := x + 1 la x de la derecha es la anterior
+        if (sv->identifiers.size() != sv->values.size()) return FAIL;
+        vector<ConstValue> values;
+        for (auto value : sv->values) {
+            ConstValue v;
+            if (!eval(value, frame, v)) return FAIL;
+            values.push_back(v);
+        }
+        size_t i = 0;
+        for (auto& name : sv->identifiers) frame.back()[name] = values[i++];
+        return NEXT;
+    }
+    if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        ImpVType type = basic_type(vd->type);
+        if (type == NOTYPE) return FAIL;
+        vector<ConstValue> values;
+        auto value = vd->values.begin();
+        for (size_t i = 0; i < vd->names.size(); i++) {
+            ConstValue v = {type, 0, ""};
+            if (value != vd->values.end() && (!eval(*value++, frame, v) || v.type != type)) return FAIL;
+            values.push_back(v);
+        }
+        size_t i = 0;
+        for (auto& name : vd->names) frame.back()[name] = values[i++];
+        return NEXT;
+    }
+    if (auto id = dynamic_cast<IncDecStmt*>(s)) {
+        ConstValue* var = lookup(frame, id->variable);
+        ConstValue one = {TINT, 1, ""}, updated;
+        if (!var || !apply_binary(id->isIncrement ? PLUS_OP : MINUS_OP, *var, one, updated)) return FAIL;
+        *var = updated;
+        return NEXT;
+    }
+    if (auto is = dynamic_cast<IfStmt*>(s)) {
+        ConstValue cond;
+        if (!eval(is->condition, frame, cond) || cond.type != TBOOL) return FAIL;
+        Block* taken = cond.number ? is->thenBlock : is->elseBlock;
+        return taken ? exec_block(taken, frame, result) : NEXT;
+    }
+    if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        frame.push_back({});
+        Flow flow = fs->init ? exec(fs->init, frame, result) : NEXT;
+        while (flow == NEXT) {
+            ConstValue cond = {TBOOL, 1, ""};
+            if (fs->condition && (!eval(fs->condition, frame, cond) || cond.type != TBOOL)) flow = FAIL;
+            if (flow != NEXT || !cond.number) break;
+            flow = exec_block(fs->body, frame, result);
+            if (flow == NEXT && fs->post) flow = exec(fs->post, frame, result);
+        }
+        frame.pop_back();
+        return flow;
+    }
+    if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        return rs->expression && eval(rs->expression, frame, result) ? RETURN : FAIL;
+    }
+    if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        return exec_block(bs->block, frame, result);
+    }
+    return FAIL;
+}
+
+CallEvaluator::Flow CallEvaluator::exec_block(Block* b, Frame& frame, ConstValue& result) {
+    frame.push_back({});
+    Flow flow = NEXT;
+    for (auto s : b->statements) {
+        flow = exec(s, frame, result);
+        if (flow != NEXT) break;
+    }
+    frame.pop_back();
+    return flow;
+}
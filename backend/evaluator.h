@@ -0,0 +1,85 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "exp.h"
+#include "imp_value.h"
+#include "options.h"
+
+using namespace std;
+
+// Valor de una expresión escalar conocido en compilación
+struct ConstValue {
+    ImpVType type;
+    long long number;
+    string text;
+};
+
+// Operaciones sobre constantes, con la aritmética de 64 bits del código generado
+// (desborde circular). Devuelven false si los tipos no corresponden, al dividir por
+// cero o con un índice fuera de rango. En s[a:b] un extremo nullptr es el que se omite
+bool apply_unary(UnaryOp op, ConstValue& value);
+bool apply_binary(BinaryOp op, const ConstValue& l, const ConstValue& r, ConstValue& out);
+bool apply_index(const ConstValue& str, const ConstValue& index, ConstValue& out);
+bool apply_slice(const ConstValue& str, const ConstValue* start, const ConstValue* end, ConstValue& out);
+
+// Evalúa una expresión de constantes: literales, operaciones entre ellos, len, s[i] y
+// s[a:b] de un string constante. Las variables de 'known' se reemplazan por su
+// inicializador; una división por cero o un índice fuera de rango no son constantes.
+bool eval_constant(Exp* e, const map<string, Exp*>& known, ConstValue& out);
+
+// Literal del AST con el valor de una constante
+Exp* constant_exp(const ConstValue& value);
+
+// Evaluación en compilación de llamadas a funciones puras con argumentos constantes
+// (fib(30) pasa a ser 832040). La usa el plegado de constantes.
+//
+// Una función es pura si sus parámetros y su resultado son int, bool o string, no
+// llama a fmt.Println, no nombra variables que no declare (las globales) y solo
+// llama a len y a otras funciones puras. Su cuerpo se interpreta sobre el AST con la
+// misma aritmética que eval_constant; si la ejecución tocaría algo que el intérprete
+// no modela (structs, una división por cero, un índice fuera de rango) la llamada
+// se deja para el programa, que fallará igual que sin la evaluación.
+//
+// Cada llamada de primer nivel tiene un presupuesto de -fconst-eval-steps=N
+// sentencias y expresiones y de -fconst-eval-depth=N llamadas anidadas, y ningún
+// string puede pasar de -fconst-eval-bytes=N bytes (r = r + r duplica en un paso);
+// al agotarlo la llamada queda como estaba. Los resultados se memorizan por
+// argumentos (una función pura siempre da lo mismo), así que una recursión como la
+// de fib cuesta una ejecución por valor distinto; la memoria deja de crecer cuando
+// sus claves y valores suman -fconst-eval-bytes=N.
+class CallEvaluator {
+private:
+    enum Flow { NEXT, RETURN, FAIL };
+    typedef vector<map<string, ConstValue>> Frame;
+
+    const CompilerOptions& options;
+    map<string, FuncDecl*> functions;
+    set<string> pure;
+    map<string, ConstValue> memo;
+    set<string> failed;
+    size_t memo_bytes;
+    long steps;
+    int depth;
+
+    bool call(FuncDecl* func, const vector<ConstValue>& args, ConstValue& out);
+    bool eval(Exp* e, Frame& frame, ConstValue& out);
+    Flow exec(Stmt* s, Frame& frame, ConstValue& result);
+    Flow exec_block(Block* b, Frame& frame, ConstValue& result);
+    ConstValue* lookup(Frame& frame, const string& name);
+    bool spend();
+    bool binary(BinaryOp op, const ConstValue& l, const ConstValue& r, ConstValue& out);
+
+public:
+    int evaluated_count;
+
+    CallEvaluator(const CompilerOptions& opts);
+    void analyze(Program* program);
+    // true si 'call' (con argumentos literales) se pudo evaluar; deja el valor en 'out'
+    bool evaluate(FunctionCallExp* call, ConstValue& out);
+};
+
+#endif
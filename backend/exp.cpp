@@ -48,7 +48,7 @@ UnaryExp::UnaryExp(Exp* e, UnaryOp operation) : exp(e), op(operation) {}
 UnaryExp::~UnaryExp() { delete exp; }
 void UnaryExp::accept(Visitor* visitor) { visitor->visit(this); }
 
-NumberExp::NumberExp(int v) : value(v) {}
+NumberExp::NumberExp(long long v) : value(v) {}
 NumberExp::~NumberExp() {}
 void NumberExp::accept(Visitor* visitor) { visitor->visit(this); }
 
@@ -79,8 +79,8 @@ FunctionCallExp::~FunctionCallExp() {
 }
 void FunctionCallExp::accept(Visitor* visitor) { visitor->visit(this); }
 
-StructLiteralExp::StructLiteralExp(const string& type, list<Exp*> vals) 
-    : typeName(type), values(vals) {}
+StructLiteralExp::StructLiteralExp(const string& type, list<Exp*> vals, list<string> names)
+    : typeName(type), values(vals), fields(names) {}
 StructLiteralExp::~StructLiteralExp() {
     for (auto val : values) delete val;
 }
@@ -148,6 +148,10 @@ ReturnStmt::ReturnStmt(Exp* exp) : expression(exp) {}
 ReturnStmt::~ReturnStmt() { if (expression) delete expression; }
 void ReturnStmt::accept(Visitor* visitor) { visitor->visit(this); }
 
+BlockStmt::BlockStmt(Block* b) : block(b) {}
+BlockStmt::~BlockStmt() { delete block; }
+void BlockStmt::accept(Visitor* visitor) { visitor->visit(this); }
+
 //=== DECLARACIONES ===
 VarDecl::VarDecl(list<string> varNames, Type* varType, list<Exp*> initValues)
     : names(varNames), type(varType), values(initValues) {}
@@ -228,6 +232,7 @@ void IfStmt::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
 void ForStmt::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
 void ReturnStmt::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
 void VarDecl::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
+void BlockStmt::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
 
 // Declaraciones
 void TypeDecl::accept(ImpValueVisitor* visitor) { visitor->visit(this); }
@@ -61,8 +61,8 @@ public:
 
 class NumberExp : public Exp {
 public:
-    int value;
-    NumberExp(int v);
+    long long value;
+    NumberExp(long long v);
     void accept(Visitor* visitor) override;
     ImpValue accept(ImpValueVisitor* visitor) override;
     ~NumberExp();
@@ -128,8 +128,9 @@ public:
 class StructLiteralExp : public Exp {
 public:
     string typeName;
-    list<Exp*> values; // Para inicialización posicional
-    StructLiteralExp(const string& type, list<Exp*> vals);
+    list<Exp*> values;
+    list<string> fields; // Campo de cada valor en un literal con claves (vacía si es posicional)
+    StructLiteralExp(const string& type, list<Exp*> vals, list<string> names = {});
     void accept(Visitor* visitor) override;
     ImpValue accept(ImpValueVisitor* visitor) override;
     ~StructLiteralExp();
@@ -261,6 +262,16 @@ public:
     ~ReturnStmt();
 };
 
+// Bloque anidado usado como sentencia: { ... }
+class BlockStmt : public Stmt {
+public:
+    class Block* block;
+    BlockStmt(Block* b);
+    void accept(Visitor* visitor) override;
+    void accept(ImpValueVisitor* visitor) override;
+    ~BlockStmt();
+};
+
 //=== DECLARACIONES ===
 class VarDecl : public Stmt {
 public:
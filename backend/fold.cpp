@@ -0,0 +1,329 @@
+#include "fold.h"
+#include <iostream>
+#include <cstdlib>
+#include "ast_utils.h"
+
+using namespace std;
+
+static bool is_literal(Exp* e) {
+    return dynamic_cast<NumberExp*>(e) || dynamic_cast<BoolExp*>(e) || dynamic_cast<StringExp*>(e);
+}
+
+// Variables que un bloque asigna o incrementa (sin contar sus declaraciones)
+static void collect_assigned_vars(Block* b, set<string>& vars);
+
+static void collect_assigned_vars(Stmt* s, set<string>& vars) {
+    if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        string base = lvalue_base(as->lhs);
+        if (!base.empty()) vars.insert(base);
+    } else if (auto id = dynamic_cast<IncDecStmt*>(s)) {
+        vars.insert(id->variable);
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        collect_assigned_vars(is->thenBlock, vars);
+        collect_assigned_vars(is->elseBlock, vars);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        if (fs->init) collect_assigned_vars(fs->init, vars);
+        if (fs->post) collect_assigned_vars(fs->post, vars);
+        collect_assigned_vars(fs->body, vars);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        collect_assigned_vars(bs->block, vars);
+    }
+}
+
+static void collect_assigned_vars(Block* b, set<string>& vars) {
+    if (!b) return;
+    for (auto s : b->statements) collect_assigned_vars(s, vars);
+}
+
+ConstantFolder::ConstantFolder(const CompilerOptions& opts)
+    : options(opts), evaluator(opts), folded_count(0), propagated_count(0) {}
+
+ConstantFolder::Binding* ConstantFolder::lookup(const string& name) {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        auto found = scope->names.find(name);
+        if (found != scope->names.end()) return found->second;
+    }
+    return nullptr;
+}
+
+// Liga un nombre nuevo en el alcance actual. 'value' ya está plegado (nullptr: el
+// cero del tipo, o un parámetro si tampoco hay tipo)
+void ConstantFolder::declare(const string& name, Exp* value, Type* type, Stmt* decl) {
+    Binding binding = {name, decl, false, false, {NOTYPE, 0, ""}};
+    bool global = scopes.size() == 1;
+    auto basic = dynamic_cast<BasicType*>(type);
+    if (!(global ? global_assigned : assigned).count(name)) {
+        if (!value && basic) {
+            binding.value = {ImpValue::get_basic_type(basic->typeName), 0, ""};
+            binding.constant = binding.value.type != NOTYPE;
+        } else if (value && is_literal(value)) {
+            eval_constant(value, {}, binding.value);
+            binding.constant = !type || (basic && ImpValue::get_basic_type(basic->typeName) == binding.value.type);
+        }
+    }
+    Scope& scope = scopes.back();
+    scope.bindings.push_back(binding);
+    scope.names[name] = &scope.bindings.back();
+}
+
+static void erase_declared(list<string>& names, list<Exp*>& values, const string& name) {
+    auto value = values.begin();
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        if (*it == name) {
+            names.erase(it);
+            if (value != values.end()) {
+                delete *value;
+                values.erase(value);
+            }
+            return;
+        }
+        if (value != values.end()) ++value;
+    }
+}
+
+static bool empty_decl(Stmt* s) {
+    auto sv = dynamic_cast<ShortVarDecl*>(s);
+    auto vd = dynamic_cast<VarDecl*>(s);
+    return (sv && sv->identifiers.empty()) || (vd && vd->names.empty());
+}
+
+// Al cerrar un alcance, las constantes cuyos usos se reemplazaron todos salen de su
+// declaración (su valor es un literal: quitarlo no pierde efectos). Las
+// declaraciones que quedan vacías las quita quien las contiene
+void ConstantFolder::close_scope() {
+    for (auto& binding : scopes.back().bindings) {
+        if (!binding.constant || binding.kept || !binding.decl) continue;
+        if (auto sv = dynamic_cast<ShortVarDecl*>(binding.decl)) {
+            erase_declared(sv->identifiers, sv->values, binding.name);
+        } else if (auto vd = dynamic_cast<VarDecl*>(binding.decl)) {
+            erase_declared(vd->names, vd->values, binding.name);
+        }
+    }
+    scopes.pop_back();
+}
+
+// s[i] fuera de rango con s constante: sobre un literal es un error de compilación,
+// pero sobre una variable tiene que fallar al ejecutarse, así que s no se reemplaza
+bool ConstantFolder::keeps_variable(IndexExp* idx) {
+    auto id = dynamic_cast<IdentifierExp*>(idx->array);
+    Binding* binding = id ? lookup(id->name) : nullptr;
+    if (!binding || !binding->constant || !is_literal(idx->index)) return false;
+    Exp* value = constant_exp(binding->value);
+    ConstValue result;
+    bool in_range = eval_constant(idx, {{id->name, value}}, result);
+    delete value;
+    if (!in_range) binding->kept = true;
+    return !in_range;
+}
+
+// Go rechaza dividir por una constante cero. Solo cuentan los literales: una
+// variable propagada que vale cero es un error al ejecutar, no al compilar
+void ConstantFolder::check_divisor(Exp* divisor) {
+    ConstValue value;
+    if (eval_constant(divisor, {}, value) && value.type == TINT && value.number == 0) {
+        cerr << "Error en tiempo de compilación: División por cero en " << context << endl;
+        exit(1);
+    }
+}
+
+// x /= 0 y x %= 0; los operadores / y % de las expresiones se revisan aparte
+void ConstantFolder::check_assign_divisions(Block* b) {
+    if (!b) return;
+    for (auto s : b->statements) {
+        list<Stmt*> stmts = {s};
+        if (auto fs = dynamic_cast<ForStmt*>(s)) stmts = {fs->init, fs->post};
+        for (auto st : stmts) {
+            auto as = dynamic_cast<AssignStmt*>(st);
+            if (as && (as->op == DIV_ASSIGN_OP || as->op == MOD_ASSIGN_OP)) check_divisor(as->rhs);
+        }
+        if (auto is = dynamic_cast<IfStmt*>(s)) {
+            check_assign_divisions(is->thenBlock);
+            check_assign_divisions(is->elseBlock);
+        } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+            check_assign_divisions(fs->body);
+        } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+            check_assign_divisions(bs->block);
+        }
+    }
+}
+
+void ConstantFolder::check_divisions(Program* program) {
+    ExpRewriter check = [&](Exp* e) -> Exp* {
+        auto bin = dynamic_cast<BinaryExp*>(e);
+        if (bin && (bin->op == DIV_OP || bin->op == MOD_OP)) check_divisor(bin->right);
+        return nullptr;
+    };
+    for (auto decl : program->globalVars) {
+        context = "la variable global " + decl->names.front();
+        for (auto value : decl->values) rewrite_exp(value, check);
+    }
+    for (auto func : program->functions) {
+        context = "la función " + func->name;
+        rewrite_block_exps(func->body, check);
+        check_assign_divisions(func->body);
+    }
+}
+
+// Devuelve la expresión que reemplaza a 'e' (la original queda liberada si cambia)
+Exp* ConstantFolder::fold(Exp* e) {
+    if (!e) return e;
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        Binding* binding = lookup(id->name);
+        if (!binding || !binding->constant) return e;
+        propagated_count++;
+        delete e;
+        return constant_exp(binding->value);
+    }
+
+    bool constant_operands = false;
+    if (auto bin = dynamic_cast<BinaryExp*>(e)) {
+        bin->left = fold(bin->left);
+        bin->right = fold(bin->right);
+        constant_operands = is_literal(bin->left) && is_literal(bin->right);
+        if (!constant_operands && (bin->op == AND_OP || bin->op == OR_OP)) {
+            // true && x es x y false && x es false (x no llega a evaluarse); x && true
+            // es x, pero x && false no se reduce porque x se evalúa igual
+            auto lb = dynamic_cast<BoolExp*>(bin->left);
+            auto rb = dynamic_cast<BoolExp*>(bin->right);
+            bool neutral = bin->op == AND_OP;
+            Exp* result = nullptr;
+            if (lb) result = lb->value == neutral ? bin->right : bin->left;
+            else if (rb && rb->value == neutral) result = bin->left;
+            if (result) {
+                (result == bin->left ? bin->left : bin->right) = nullptr;
+                delete bin;
+                folded_count++;
+                return result;
+            }
+        }
+        if ((bin->op == PLUS_OP || bin->op == MUL_OP) && dynamic_cast<NumberExp*>(bin->left) &&
+            !constant_operands) {
+            swap(bin->left, bin->right);
+        }
+    } else if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        u->exp = fold(u->exp);
+        constant_operands = is_literal(u->exp);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        fa->object = fold(fa->object);
+    } else if (auto idx = dynamic_cast<IndexExp*>(e)) {
+        idx->index = fold(idx->index);
+        if (!keeps_variable(idx)) idx->array = fold(idx->array);
+        constant_operands = is_literal(idx->array) && is_literal(idx->index);
+    } else if (auto slice = dynamic_cast<SliceExp*>(e)) {
+        slice->array = fold(slice->array);
+        slice->start = fold(slice->start);
+        slice->end = fold(slice->end);
+        constant_operands = is_literal(slice->array) && (!slice->start || is_literal(slice->start)) &&
+                            (!slice->end || is_literal(slice->end));
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        bool literal_args = true;
+        for (auto& arg : call->args) {
+            arg = fold(arg);
+            literal_args = literal_args && is_literal(arg);
+        }
+        ConstValue result;
+        if (literal_args && evaluator.evaluate(call, result)) {
+            delete e;
+            return constant_exp(result);
+        }
+        constant_operands = call->funcName == "len" && literal_args;
+    } else if (auto lit = dynamic_cast<StructLiteralExp*>(e)) {
+        for (auto& value : lit->values) value = fold(value);
+    }
+
+    ConstValue value;
+    if (!constant_operands || !eval_constant(e, {}, value)) return e;
+    folded_count++;
+    delete e;
+    return constant_exp(value);
+}
+
+void ConstantFolder::fold_stmt(Stmt* s) {
+    if (auto es = dynamic_cast<ExprStmt*>(s)) {
+        es->expression = fold(es->expression);
+    } else if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        as->rhs = fold(as->rhs);
+    } else if (auto sv = dynamic_cast<ShortVarDecl*>(s)) {
+        // Los valores se pliegan antes de ligar: en x := x + 1 la x de la derecha es la anterior
+        for (auto& value : sv->values) value = fold(value);
+        auto value = sv->values.begin();
+        for (auto& name : sv->identifiers) {
+            // Una declaración incompleta se liga igual; el generador la rechaza
+            declare(name, value != sv->values.end() ? *value++ : nullptr, nullptr, s);
+        }
+    } else if (auto vd = dynamic_cast<VarDecl*>(s)) {
+        for (auto& value : vd->values) value = fold(value);
+        auto value = vd->values.begin();
+        for (auto& name : vd->names) {
+            declare(name, value != vd->values.end() ? *value++ : nullptr, vd->type, s);
+        }
+    } else if (auto is = dynamic_cast<IfStmt*>(s)) {
+        is->condition = fold(is->condition);
+        fold_block(is->thenBlock);
+        fold_block(is->elseBlock);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        scopes.push_back({});
+        if (fs->init) fold_stmt(fs->init);
+        fs->condition = fold(fs->condition);
+        if (fs->post) fold_stmt(fs->post);
+        fold_block(fs->body);
+        close_scope();
+        if (empty_decl(fs->init)) {
+            delete fs->init;
+            fs->init = nullptr;
+        }
+    } else if (auto rs = dynamic_cast<ReturnStmt*>(s)) {
+        rs->expression = fold(rs->expression);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        fold_block(bs->block);
+    }
+}
+
+void ConstantFolder::fold_block(Block* b) {
+    if (!b) return;
+    scopes.push_back({});
+    for (auto s : b->statements) fold_stmt(s);
+    close_scope();
+    auto& stmts = b->statements;
+    for (auto it = stmts.begin(); it != stmts.end();) {
+        if (!empty_decl(*it)) {
+            ++it;
+            continue;
+        }
+        delete *it;
+        it = stmts.erase(it);
+    }
+}
+
+void ConstantFolder::run(Program* program) {
+    if (!options.fold) return;
+    evaluator.analyze(program);
+    map<FuncDecl*, set<string>> assigned_by;
+    for (auto func : program->functions) {
+        collect_assigned_vars(func->body, assigned_by[func]);
+        global_assigned.insert(assigned_by[func].begin(), assigned_by[func].end());
+    }
+
+    // Cada global ve a las anteriores, en el orden en que se inicializan
+    scopes.push_back({});
+    for (auto decl : program->globalVars) {
+        auto value = decl->values.begin();
+        for (auto& name : decl->names) {
+            Exp* init = nullptr;
+            if (value != decl->values.end()) {
+                *value = fold(*value);
+                init = *value++;
+            }
+            declare(name, init, decl->type, nullptr);
+        }
+    }
+
+    for (auto func : program->functions) {
+        assigned = assigned_by[func];
+        scopes.push_back({});
+        for (auto& param : func->params) declare(param.first, nullptr, nullptr, nullptr);
+        fold_block(func->body);
+        scopes.pop_back();
+    }
+    scopes.pop_back();
+}
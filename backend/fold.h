@@ -0,0 +1,77 @@
+#ifndef FOLD_H
+#define FOLD_H
+
+#include <map>
+#include <set>
+#include <list>
+#include <string>
+#include <vector>
+#include "exp.h"
+#include "options.h"
+#include "evaluator.h"
+
+using namespace std;
+
+// Plegado y propagación de constantes sobre el AST, después del inlining (que deja
+// a la vista los argumentos constantes):
+//  - Cada subexpresión cuyos operandos son constantes se reemplaza por su valor, y
+//    true/false a un lado de && o || se simplifican (x && true es x).
+//  - Una variable local inicializada con una constante (o declarada sin valor, con
+//    el cero de su tipo) que la función nunca vuelve a asignar se reemplaza en cada
+//    uso por su valor, y su declaración desaparece. Lo mismo una global que ninguna
+//    función asigna, aunque su declaración se conserva.
+//  - Una llamada a una función pura con argumentos constantes se reemplaza por su
+//    resultado si CallEvaluator la evalúa dentro de su presupuesto.
+//  - En c + e y c * e la constante pasa a la derecha, donde el generador la usa como
+//    inmediato.
+// Las condiciones que quedan constantes las resuelve la eliminación de código
+// muerto, que corre a continuación.
+//
+// Dividir por una expresión de solo literales que vale cero es un error de
+// compilación, como en Go, también con -fno-fold. Si el cero llega por una
+// variable o un argumento, la división no se pliega y falla al ejecutarse.
+class ConstantFolder {
+private:
+    struct Binding {
+        string name;
+        Stmt* decl;    // Declaración local que la introduce (nullptr: global o parámetro)
+        bool constant;
+        bool kept;     // Algún uso conserva la variable, que entonces sigue declarada
+        ConstValue value;
+    };
+    struct Scope {
+        map<string, Binding*> names;
+        list<Binding> bindings;
+    };
+
+    const CompilerOptions& options;
+    CallEvaluator evaluator;
+    // Alcances léxicos abiertos; el primero es el de las globales
+    vector<Scope> scopes;
+    // Variables que la función actual (o, para las globales, alguna función) asigna
+    set<string> assigned;
+    set<string> global_assigned;
+    string context;
+
+    Binding* lookup(const string& name);
+    void declare(const string& name, Exp* value, Type* type, Stmt* decl);
+    void close_scope();
+    bool keeps_variable(IndexExp* idx);
+    void check_divisor(Exp* divisor);
+    void check_assign_divisions(Block* b);
+    Exp* fold(Exp* e);
+    void fold_stmt(Stmt* s);
+    void fold_block(Block* b);
+
+public:
+    int folded_count;
+    int propagated_count;
+
+    ConstantFolder(const CompilerOptions& opts);
+    // Rechaza las divisiones por una constante cero; corre antes del inlining, que
+    // podría dejar un argumento 0 como divisor literal
+    void check_divisions(Program* program);
+    void run(Program* program);
+};
+
+#endif
@@ -3,46 +3,313 @@
 #include <algorithm>
 #include <stdexcept>
 #include <vector>
+#include <set>
+#include <cstdint>
+#include "ast_utils.h"
+#include "evaluator.h"
 #include "helpers_gencode.cpp" 
 
 using namespace std;
 
-GoCodeGen::GoCodeGen(std::ostream& out) 
-    : current_offset(0), label_counter(0), string_counter(0), output(out) {
+// Registros de argumentos enteros de la convención System V AMD64
+static const char* ARG_REGS[] = {"%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9"};
+static const int NUM_ARG_REGS = 6;
+// Los locales ocupan múltiplos de 8 bytes para que todos queden alineados
+static int frame_bytes(int size) { return (size + 7) & -8; }
+
+// Bytes debajo de %rsp que el ABI garantiza que no se pisan (red zone)
+static const int RED_ZONE_SIZE = 128;
+// Bytes del buffer de salida de fmt.Println
+static const int OUTPUT_BUFFER_SIZE = 65536;
+// Pila alternativa del manejador de señales fatales (un desborde de pila agota la normal)
+static const int SIGNAL_STACK_SIZE = 65536;
+// Reservador del runtime (_go_alloc): chunks que se piden al sistema, bloques
+// pequeños (clases de 16 en 16 bytes) y medianos (clases potencia de 2); los más
+// grandes tienen su propio mapeo
+static const int ALLOC_CHUNK_SIZE = 1 << 20;
+static const int ALLOC_SMALL_MAX = 1024;
+static const int ALLOC_MEDIUM_MAX = 65536;
+// Máximo de chunks y bloques grandes anotados en _alloc_chunks
+static const int ALLOC_MAX_CHUNKS = 4096;
+// Offset desde el que se ubican las globales, lejos de cualquier offset del marco
+static const int GLOBAL_BASE = 1 << 30;
+// Los inmediatos de x86-64 son de 32 bits con signo; una constante más grande se
+// carga con movabsq
+static bool fits_imm32(long long value) { return value >= INT32_MIN && value <= INT32_MAX; }
+
+GoCodeGen::GoCodeGen(std::ostream& out, const CompilerOptions& opts) 
+    : current_offset(0), label_counter(0), string_counter(0), output(out), options(opts),
+      current_function(nullptr), sret_slot(0), stack_depth(0), max_stack_depth(0), frame_size(0),
+      made_call(false), frame_omitted(false), escapes(options), temp_area(0) {
     this->needs_string_concat = false;
     this->needs_string_compare = false;
+    this->needs_string_append = false;
+    this->needs_string_concat_n = false;
+    this->needs_bounds_checks = false;
+    this->needs_divide_check = false;
+    this->needs_output_buffer = false;
 }
 
 string GoCodeGen::new_label() { return "L" + to_string(label_counter++); }
 
+void GoCodeGen::push_reg(const string& reg, bool pointer) {
+    stack_depth += 8;
+    max_stack_depth = max(max_stack_depth, stack_depth);
+    if (frame_omitted) {
+        output << "  movq " << reg << ", " << -(frame_size + stack_depth) << "(%rsp)" << endl;
+    } else {
+        output << "  pushq " << reg << endl;
+        if (pointer) note_pointer_area({0});
+    }
+}
+
+void GoCodeGen::pop_reg(const string& reg) {
+    if (frame_omitted) {
+        output << "  movq " << -(frame_size + stack_depth) << "(%rsp), " << reg << endl;
+    } else {
+        output << "  popq " << reg << endl;
+    }
+    stack_depth -= 8;
+    release_pointer_temps();
+}
+
+void GoCodeGen::string_words(const string& struct_name, int base, vector<int>& out) {
+    StructInfo info = env.get_struct(struct_name);
+    for (auto& name : info.field_order) {
+        const FieldInfo& field = info.fields[name];
+        if (!field.struct_name.empty()) string_words(field.struct_name, base + field.offset, out);
+        else if (field.type == TSTRING) out.push_back(base + field.offset);
+    }
+}
+
+// Sin marco no hay llamadas, así que tampoco raíces que anotar
+void GoCodeGen::note_pointer_area(const vector<int>& offsets) {
+    if (frame_omitted) return;
+    for (int offset : offsets) pointer_temps.push_back(stack_top_offset() + offset);
+}
+
+void GoCodeGen::release_pointer_temps() {
+    if (frame_omitted) return;
+    int top = stack_top_offset();
+    pointer_temps.erase(remove_if(pointer_temps.begin(), pointer_temps.end(), [&](int o) { return o < top; }),
+                        pointer_temps.end());
+}
+
+// Raíces en este punto: los strings de las variables visibles (y de los campos de
+// los structs) y los temporales anotados que siguen en la pila
+void GoCodeGen::record_gc_site() {
+    if (!gc_enabled() || frame_omitted) return;
+    GcSite site;
+    site.label = "_gc_site_" + to_string(gc_sites.size());
+    for (auto& var : env.visible_vars()) {
+        if (is_global_slot(var.offset)) continue;
+        if (!var.struct_name.empty()) string_words(var.struct_name, var.offset, site.offsets);
+        else if (var.type == TSTRING) site.offsets.push_back(var.offset);
+    }
+    site.offsets.insert(site.offsets.end(), pointer_temps.begin(), pointer_temps.end());
+    sort(site.offsets.begin(), site.offsets.end());
+    site.offsets.erase(unique(site.offsets.begin(), site.offsets.end()), site.offsets.end());
+    output << site.label << ":" << endl;
+    gc_sites.push_back(site);
+}
+
+void GoCodeGen::emit_load(int offset, int size, const string& reg, const string& reg2) {
+    output << "  " << (size == 1 ? "movzbq " : "movq ") << frame_slot(offset) << ", " << reg << endl;
+    if (size == 16) output << "  movq " << frame_slot(offset + 8) << ", " << reg2 << endl;
+}
+
+void GoCodeGen::emit_store(const StructPlace& dest, int size) {
+    string operand = place_operand(dest);
+    output << "  " << (size == 1 ? "movb %al, " : "movq %rax, ") << operand << endl;
+    if (size == 16) {
+        string len_operand = dest.pointer_slot ? to_string(dest.offset + 8) + "(%r11)" : frame_slot(dest.offset + 8);
+        output << "  movq %rdx, " << len_operand << endl;
+    }
+}
+
+static const char* MOV_SUFFIXES[] = {"q", "l", "w", "b"};
+static const char* RAX_PARTS[] = {"%rax", "%eax", "%ax", "%al"};
+static const char* RDX_PARTS[] = {"%rdx", "%edx", "%dx", "%dl"};
+
+// Operando de memoria de un lugar; si es indirecto, antes carga su base en %r11
+string GoCodeGen::place_operand(const StructPlace& place) {
+    if (!place.pointer_slot) return frame_slot(place.offset);
+    output << "  movq " << frame_slot(place.pointer_slot) << ", %r11" << endl;
+    return to_string(place.offset) + "(%r11)";
+}
+
+void GoCodeGen::load_place_address(const StructPlace& place, const string& reg) {
+    if (!place.pointer_slot) {
+        output << "  leaq " << frame_slot(place.offset) << ", " << reg << endl;
+        return;
+    }
+    output << "  movq " << frame_slot(place.pointer_slot) << ", " << reg << endl;
+    if (place.offset) output << "  leaq " << place.offset << "(" << reg << "), " << reg << endl;
+}
+
+// Pone en cero 'size' bytes desde 'dest'. Desde struct_rep_threshold bytes se usa
+// rep stosq; si no, stores SSE2 de 16 bytes (movups: el marco solo garantiza
+// alineación a 8). El resto se completa con movs más angostos.
+// Usa %rax, %rcx, %rdi, %r11 y %xmm0.
+void GoCodeGen::emit_zero(const StructPlace& dest, int size) {
+    if (dest.pointer_slot) load_place_address(dest, "%r11");
+    auto operand = [&](int at) {
+        return dest.pointer_slot ? to_string(at) + "(%r11)" : frame_slot(dest.offset + at);
+    };
+    int at = 0;
+    if (options.struct_block_ops && size >= options.struct_rep_threshold) {
+        output << "  leaq " << operand(0) << ", %rdi" << endl;
+        output << "  xorl %eax, %eax" << endl;
+        output << "  movl $" << size / 8 << ", %ecx" << endl;
+        output << "  rep stosq" << endl;
+        at = size & -8;
+    } else if (options.struct_block_ops && size >= 16) {
+        output << "  pxor %xmm0, %xmm0" << endl;
+        for (; size - at >= 16; at += 16) {
+            output << "  movups %xmm0, " << operand(at) << endl;
+        }
+    }
+    int width = 8;
+    for (auto suffix : MOV_SUFFIXES) {
+        for (; size - at >= width; at += width) {
+            output << "  mov" << suffix << " $0, " << operand(at) << endl;
+        }
+        width /= 2;
+    }
+}
+
+// Copia 'size' bytes del marco desde 'src' a 'dest' (nunca se solapan: son el mismo
+// struct o dos distintos). Desde struct_rep_threshold bytes usa rep movsq y si no,
+// movs de 8 bytes por %rax: el origen suele tener campos recién escritos con stores
+// de 8 bytes, y una carga SSE de 16 bytes sobre ellos no recibe el dato por store
+// forwarding y espera a que lleguen a la caché. Usa %rax, %rcx, %rsi, %rdi y %r11.
+void GoCodeGen::emit_copy(const StructPlace& dest, int src, int size) {
+    if (!dest.pointer_slot && dest.offset == src) return;
+    if (dest.pointer_slot) load_place_address(dest, "%r11");
+    auto operand = [&](int at) {
+        return dest.pointer_slot ? to_string(at) + "(%r11)" : frame_slot(dest.offset + at);
+    };
+    int at = 0;
+    if (options.struct_block_ops && size >= options.struct_rep_threshold) {
+        output << "  leaq " << frame_slot(src) << ", %rsi" << endl;
+        output << "  leaq " << operand(0) << ", %rdi" << endl;
+        output << "  movl $" << size / 8 << ", %ecx" << endl;
+        output << "  rep movsq" << endl;
+        at = size & -8;
+    }
+    int width = 8;
+    for (int i = 0; i < 4; i++, width /= 2) {
+        for (; size - at >= width; at += width) {
+            output << "  mov" << MOV_SUFFIXES[i] << " " << frame_slot(src + at) << ", " << RAX_PARTS[i] << endl;
+            output << "  mov" << MOV_SUFFIXES[i] << " " << RAX_PARTS[i] << ", " << operand(at) << endl;
+        }
+    }
+}
+
+// Los structs de hasta 16 bytes vuelven en %rax:%rdx; al guardarlos solo se escriben
+// sus bytes, porque pueden ser un campo seguido de otros dentro de un struct mayor
+void GoCodeGen::emit_store_bytes(bool from_rdx, const StructPlace& dest, int size) {
+    const char** parts = from_rdx ? RDX_PARTS : RAX_PARTS;
+    if (dest.pointer_slot) load_place_address(dest, "%r11");
+    auto operand = [&](int at) {
+        return dest.pointer_slot ? to_string(at) + "(%r11)" : frame_slot(dest.offset + at);
+    };
+    int at = 0, width = 8;
+    for (int i = 0; i < 4; i++, width /= 2) {
+        if (size - at < width) continue;
+        output << "  mov" << MOV_SUFFIXES[i] << " " << parts[i] << ", " << operand(at) << endl;
+        at += width;
+        if (at < size) output << "  shrq $" << width * 8 << ", " << parts[0] << endl;
+    }
+}
+
+int GoCodeGen::stack_top_offset() {
+    return -(((frame_size + 15) & -16) + stack_depth);
+}
+
+// Helpers del runtime que reservan memoria (y pueden disparar el recolector)
+static const set<string> ALLOCATING_HELPERS = {"_concat_strings", "_concat_strings_into", "_concat_strings_n",
+                                               "_concat_strings_n_into", "_append_string"};
+
+void GoCodeGen::emit_call(const string& target) {
+    made_call = true;
+    bool safepoint = ALLOCATING_HELPERS.count(target) > 0;
+    if (stack_depth % 16 != 0) {
+        output << "  subq $8, %rsp # Alinea la pila a 16 bytes" << endl;
+        output << "  call " << target << endl;
+        if (safepoint) record_gc_site();
+        output << "  addq $8, %rsp" << endl;
+    } else {
+        output << "  call " << target << endl;
+        if (safepoint) record_gc_site();
+    }
+}
+
 void GoCodeGen::generateCode(Program* program) {
     try {
         env.clear();
         env.add_level();
         
-        StructCollectorVisitor struct_collector(env);
+        StructCollectorVisitor struct_collector(env, options.struct_reorder);
         program->accept(&struct_collector);
 
         StringCollectorVisitor string_collector(this->string_literals, this->string_counter);
         program->accept(&string_collector);
+
+        // Lo que no se inicializa en compilación corre en _go_init, que main llama
+        // antes que nada; es una función más para el resto de la generación
+        list<Stmt*> init = layout_globals(program);
+        if (!init.empty()) {
+            program->functions.push_back(new FuncDecl("_go_init", {}, nullptr, new Block(init)));
+            for (auto f : program->functions) {
+                if (f->name == "main" && f->body) {
+                    f->body->statements.push_front(new ExprStmt(new FunctionCallExp("_go_init", {})));
+                }
+            }
+        }
         
+        // Primero las firmas: el tamaño de los marcos depende de qué funciones devuelven structs
         for (auto f : program->functions) {
-            ImpVType retType = NOTYPE;
-            if (f->returnType) {
-                if (auto bt = dynamic_cast<BasicType*>(f->returnType)) {
-                    retType = ImpValue::get_basic_type(bt->typeName);
-                }
+            FuncInfo info;
+            info.stack_size = 0;
+            info.return_type = NOTYPE;
+            if (auto bt = dynamic_cast<BasicType*>(f->returnType)) {
+                info.return_type = ImpValue::get_basic_type(bt->typeName);
+            } else if (auto id_type = dynamic_cast<IdentifierType*>(f->returnType)) {
+                info.return_struct = id_type->name;
             }
-            env.add_function(f->name, {calculate_block_size(f->body), retType});
+            for (auto& param : f->params) {
+                auto bt = dynamic_cast<BasicType*>(param.second);
+                auto id_type = dynamic_cast<IdentifierType*>(param.second);
+                info.param_types.push_back(bt ? ImpValue::get_basic_type(bt->typeName) : NOTYPE);
+                info.param_structs.push_back(id_type ? id_type->name : "");
+            }
+            env.add_function(f->name, info);
+        }
+        escapes.run(program);
+        if (options.escape_report) escapes.print_stats(cerr);
+        for (auto f : program->functions) {
+            FuncInfo info = env.get_function(f->name);
+            info.stack_size = calculate_function_size(f);
+            env.add_function(f->name, info);
         }
         
+        set<string> called;
+        for (auto f : program->functions) collect_called_functions(f->body, called);
+        needs_output_buffer = options.buffered_output && called.count("fmt.Println");
+
         current_offset = 0;
         label_counter = 0;
 
+        if (options.frame_report) cerr << "=== MARCOS DE PILA ===" << endl;
         generate_prologue();
         program->accept(this); 
 
         generate_runtime_helpers(); 
+        generate_globals();
+        // Al final, porque la generación puede agregar literales (concatenaciones plegadas)
+        output << ".section .rodata" << endl;
+        generate_string_literals();
         generate_epilogue();
 
     } catch (const std::runtime_error& e) {
@@ -52,11 +319,21 @@ void GoCodeGen::generateCode(Program* program) {
 
 void GoCodeGen::generate_prologue() {
     output << ".data" << endl;
-    output << "print_fmt: .string \"%ld\\n\"" << endl;
-    output << "print_str_fmt: .string \"%s\\n\"" << endl;
-    output << "print_bool_true: .string \"true\\n\"" << endl;
-    output << "print_bool_false: .string \"false\\n\"" << endl;
-    generate_string_literals();
+    // Cada argumento de fmt.Println va seguido de su separador (espacio o salto de línea)
+    output << "print_fmt: .string \"%ld%c\"" << endl;
+    output << "print_str_fmt: .string \"%.*s%c\"" << endl;
+    output << "print_bool_fmt: .string \"%s%c\"" << endl;
+    output << "print_bool_true: .string \"true\"" << endl;
+    output << "print_bool_false: .string \"false\"" << endl;
+    // Como en Go, los mensajes muestran solo el índice o el extremo que falló, y el
+    // largo solo si el valor no es negativo
+    output << "panic_index_fmt: .string \"panic: runtime error: index out of range [%ld] with length %ld\\n\"" << endl;
+    output << "panic_index_neg_fmt: .string \"panic: runtime error: index out of range [%ld]\\n\"" << endl;
+    output << "panic_slice_high_fmt: .string \"panic: runtime error: slice bounds out of range [:%ld] with length %ld\\n\"" << endl;
+    output << "panic_slice_high_neg_fmt: .string \"panic: runtime error: slice bounds out of range [:%ld]\\n\"" << endl;
+    output << "panic_slice_low_fmt: .string \"panic: runtime error: slice bounds out of range [%ld:%ld]\\n\"" << endl;
+    output << "panic_slice_low_neg_fmt: .string \"panic: runtime error: slice bounds out of range [%ld:]\\n\"" << endl;
+    output << "panic_divide_fmt: .string \"panic: runtime error: integer divide by zero\\n\"" << endl;
     output << ".text" << endl;
 }
 
@@ -64,8 +341,675 @@ void GoCodeGen::generate_epilogue() {
     output << ".section .note.GNU-stack,\"\",@progbits" << endl;
 }
 
+string GoCodeGen::string_label(const string& value) {
+    used_literals.insert(value);
+    auto found = string_literals.find(value);
+    if (found != string_literals.end()) return found->second;
+    string label = "string_" + to_string(string_counter++);
+    string_literals[value] = label;
+    return label;
+}
+
+// Capa de salida de fmt.Println: un buffer de OUTPUT_BUFFER_SIZE bytes que se vacía
+// con la llamada al sistema write cuando se llena, al terminar main y antes de un
+// panic. Sin printf no hay cadenas de formato que interpretar ni locks de stdio.
+// Salvo _out_install, estas rutinas no llaman a la libc, así que no necesitan la pila
+// alineada.
+void GoCodeGen::generate_output_runtime() {
+    int size = OUTPUT_BUFFER_SIZE;
+
+    // _out_install (lo llama main al entrar) instala _out_fatal para SIGSEGV, SIGFPE
+    // y SIGBUS sobre una pila propia: lo impreso hasta una falla (un desborde de pila,
+    // el mínimo entero dividido por -1) sale antes de que el programa muera. Con
+    // SA_RESETHAND la acción vuelve a la de omisión, y al retornar la instrucción que
+    // falló se repite y termina el proceso con la misma señal
+    output << "_out_install:" << endl;
+    output << "  pushq %rbp" << endl;
+    output << "  movq %rsp, %rbp" << endl;
+    output << "  andq $-16, %rsp" << endl;
+    output << "  subq $160, %rsp" << endl;
+    output << "  leaq _out_signal_stack(%rip), %rax" << endl;
+    output << "  movq %rax, (%rsp)" << endl;
+    output << "  movq $0, 8(%rsp)" << endl;
+    output << "  movq $" << SIGNAL_STACK_SIZE << ", 16(%rsp)" << endl;
+    output << "  movq %rsp, %rdi" << endl;
+    output << "  xorl %esi, %esi" << endl;
+    output << "  call sigaltstack@PLT" << endl;
+    // struct sigaction: manejador, máscara vacía (128 bytes) y banderas en el byte 136
+    output << "  movq %rsp, %rdi" << endl;
+    output << "  xorl %eax, %eax" << endl;
+    output << "  movl $152, %ecx" << endl;
+    output << "  rep stosb" << endl;
+    output << "  leaq _out_fatal(%rip), %rax" << endl;
+    output << "  movq %rax, (%rsp)" << endl;
+    output << "  movl $0x88000000, 136(%rsp)" << endl; // SA_ONSTACK | SA_RESETHAND
+    for (int sig : {11, 8, 7}) {
+        output << "  movl $" << sig << ", %edi" << endl;
+        output << "  movq %rsp, %rsi" << endl;
+        output << "  xorl %edx, %edx" << endl;
+        output << "  call sigaction@PLT" << endl;
+    }
+    output << "  leave" << endl;
+    output << "  ret" << endl;
+    output << "_out_fatal:" << endl;
+    output << "  call _out_flush" << endl;
+    output << "  ret" << endl;
+
+    // _out_write escribe %rdx bytes desde %rsi en la salida estándar (reintenta las
+    // escrituras parciales y las interrumpidas)
+    output << "_out_flush:" << endl;
+    output << "  movq _out_len(%rip), %rdx" << endl;
+    output << "  leaq _out_buf(%rip), %rsi" << endl;
+    output << "  movq $0, _out_len(%rip)" << endl;
+    output << "_out_write:" << endl;
+    output << "1:" << endl;
+    output << "  testq %rdx, %rdx" << endl;
+    output << "  jle 2f" << endl;
+    output << "  movl $1, %eax" << endl;
+    output << "  movl $1, %edi" << endl;
+    output << "  syscall" << endl;
+    output << "  cmpq $-4, %rax" << endl; // EINTR
+    output << "  je 1b" << endl;
+    output << "  testq %rax, %rax" << endl;
+    output << "  jle 2f" << endl;
+    output << "  addq %rax, %rsi" << endl;
+    output << "  subq %rax, %rdx" << endl;
+    output << "  jmp 1b" << endl;
+    output << "2:" << endl;
+    output << "  ret" << endl;
+
+    // _out_str(puntero, largo, separador). Lo que no entra ni con el buffer vacío se
+    // escribe directamente
+    output << "_out_str:" << endl;
+    output << "  movq _out_len(%rip), %r8" << endl;
+    output << "  leaq 1(%rsi,%r8), %rax" << endl;
+    output << "  cmpq $" << size << ", %rax" << endl;
+    output << "  jbe 1f" << endl;
+    output << "  pushq %rdi" << endl;
+    output << "  pushq %rsi" << endl;
+    output << "  pushq %rdx" << endl;
+    output << "  call _out_flush" << endl;
+    output << "  popq %rdx" << endl;
+    output << "  popq %rsi" << endl;
+    output << "  popq %rdi" << endl;
+    output << "  xorl %r8d, %r8d" << endl;
+    output << "  cmpq $" << size << ", %rsi" << endl;
+    output << "  jb 1f" << endl;
+    output << "  pushq %rdx" << endl;
+    output << "  movq %rsi, %rdx" << endl;
+    output << "  movq %rdi, %rsi" << endl;
+    output << "  call _out_write" << endl;
+    output << "  popq %rdx" << endl;
+    output << "  xorl %esi, %esi" << endl;
+    output << "1:" << endl;
+    output << "  leaq _out_buf(%rip), %r9" << endl;
+    output << "  movq %rsi, %rcx" << endl;
+    output << "  movq %rdi, %rsi" << endl;
+    output << "  leaq (%r9,%r8), %rdi" << endl;
+    output << "  addq %rcx, %r8" << endl;
+    output << "  rep movsb" << endl;
+    output << "  movb %dl, (%r9,%r8)" << endl;
+    output << "  incq %r8" << endl;
+    output << "  movq %r8, _out_len(%rip)" << endl;
+    output << "  ret" << endl;
+
+    // _out_bool(valor, separador)
+    output << "_out_bool:" << endl;
+    output << "  movl %esi, %edx" << endl;
+    output << "  leaq print_bool_true(%rip), %rax" << endl;
+    output << "  leaq print_bool_false(%rip), %rcx" << endl;
+    output << "  movl $4, %esi" << endl;
+    output << "  movl $5, %r8d" << endl;
+    output << "  testq %rdi, %rdi" << endl;
+    output << "  cmoveq %rcx, %rax" << endl;
+    output << "  cmovel %r8d, %esi" << endl;
+    output << "  movq %rax, %rdi" << endl;
+    output << "  jmp _out_str" << endl;
+
+    // _out_int(valor, separador). El valor absoluto se trata sin signo (así
+    // -9223372036854775808 también sale bien) y se divide por 100 multiplicando por
+    // el recíproco; cada resto sale de una tabla de pares de dígitos. Los dígitos se
+    // arman de derecha a izquierda en la red zone y se copian con tres movq fijos
+    // (el buffer siempre tiene 32 bytes libres), sin bucle de copia.
+    output << "_out_int:" << endl;
+    output << "  movq _out_len(%rip), %r8" << endl;
+    output << "  cmpq $" << size - 32 << ", %r8" << endl;
+    output << "  jbe 1f" << endl;
+    output << "  pushq %rdi" << endl;
+    output << "  pushq %rsi" << endl;
+    output << "  call _out_flush" << endl;
+    output << "  popq %rsi" << endl;
+    output << "  popq %rdi" << endl;
+    output << "  xorl %r8d, %r8d" << endl;
+    output << "1:" << endl;
+    output << "  leaq _out_buf(%rip), %r9" << endl;
+    output << "  movq %rdi, %rax" << endl;
+    output << "  testq %rax, %rax" << endl;
+    output << "  jns 2f" << endl;
+    output << "  movb $45, (%r9,%r8)" << endl;
+    output << "  incq %r8" << endl;
+    output << "  negq %rax" << endl;
+    output << "2:" << endl;
+    output << "  leaq -8(%rsp), %r10" << endl;
+    output << "  leaq _digit_pairs(%rip), %rdi" << endl;
+    output << "3:" << endl;
+    output << "  cmpq $100, %rax" << endl;
+    output << "  jb 4f" << endl;
+    output << "  movq %rax, %rcx" << endl;
+    output << "  shrq $2, %rax" << endl;
+    output << "  movabsq $2951479051793528259, %rdx" << endl;
+    output << "  mulq %rdx" << endl;
+    output << "  shrq $2, %rdx" << endl;
+    output << "  imulq $100, %rdx, %rax" << endl;
+    output << "  subq %rax, %rcx" << endl;
+    output << "  movq %rdx, %rax" << endl;
+    output << "  movzwl (%rdi,%rcx,2), %ecx" << endl;
+    output << "  subq $2, %r10" << endl;
+    output << "  movw %cx, (%r10)" << endl;
+    output << "  jmp 3b" << endl;
+    output << "4:" << endl;
+    output << "  cmpq $10, %rax" << endl;
+    output << "  jb 5f" << endl;
+    output << "  movzwl (%rdi,%rax,2), %eax" << endl;
+    output << "  subq $2, %r10" << endl;
+    output << "  movw %ax, (%r10)" << endl;
+    output << "  jmp 6f" << endl;
+    output << "5:" << endl;
+    output << "  addl $48, %eax" << endl;
+    output << "  decq %r10" << endl;
+    output << "  movb %al, (%r10)" << endl;
+    output << "6:" << endl;
+    output << "  leaq -8(%rsp), %rcx" << endl;
+    output << "  subq %r10, %rcx" << endl;
+    for (int i = 0; i < 24; i += 8) {
+        output << "  movq " << i << "(%r10), %rax" << endl;
+        output << "  movq %rax, " << i << "(%r9,%r8)" << endl;
+    }
+    output << "  addq %rcx, %r8" << endl;
+    output << "  movb %sil, (%r9,%r8)" << endl;
+    output << "  incq %r8" << endl;
+    output << "  movq %r8, _out_len(%rip)" << endl;
+    output << "  ret" << endl;
+
+    output << ".section .rodata" << endl;
+    output << "_digit_pairs: .ascii \"";
+    for (int i = 0; i < 100; i++) output << i / 10 << i % 10;
+    output << "\"" << endl;
+    output << ".bss" << endl;
+    output << ".align 64" << endl;
+    output << "_out_buf: .zero " << size << endl;
+    output << "_out_len: .zero 8" << endl;
+    output << ".align 16" << endl;
+    output << "_out_signal_stack: .zero " << SIGNAL_STACK_SIZE << endl;
+    output << ".text" << endl;
+}
+
+// Todas las reservas del código generado pasan por _go_alloc (%rdi = bytes, devuelve
+// el puntero en %rax) y se devuelven con _go_free. Cada bloque lleva 8 bytes de
+// encabezado con su tamaño, múltiplo de 16, y en los bits bajos si es grande (1),
+// si está libre (2) y la marca del recolector (4).
+// Los bloques libres se enlazan por clase de tamaño a través de su primera palabra;
+// sin bloque libre se avanza un puntero dentro del chunk actual y, si no alcanza, se
+// mapea otro (lo que sobraba del anterior, menos de un bloque mediano, se pierde).
+// Cada chunk empieza con un bitmap con un bit por cada 16 bytes que marca dónde
+// empieza un bloque, para encontrar el bloque de un puntero interior (una vista
+// s[a:b]). Los bloques grandes se mapean aparte y se liberan con munmap. Chunks y
+// bloques grandes se anotan en _alloc_chunks (base, fin, 1 si es grande). Como el
+// buffer de salida, usa llamadas al sistema directas.
+// Con -fno-arena ambas rutinas saltan a malloc y free de la libc (y no hay recolector)
+void GoCodeGen::generate_alloc_runtime() {
+    if (!options.arena_alloc) {
+        output << "_go_alloc:" << endl;
+        output << "  jmp malloc@PLT" << endl;
+        output << "_go_free:" << endl;
+        output << "  jmp free@PLT" << endl;
+        return;
+    }
+    int small_classes = ALLOC_SMALL_MAX / 16;
+    int small_bits = __builtin_ctz(ALLOC_SMALL_MAX);
+    int classes = small_classes + __builtin_ctz(ALLOC_MEDIUM_MAX) - small_bits;
+    // Clase de un bloque mediano de 2^k bytes: k + medium_base
+    int medium_base = small_classes - small_bits - 1;
+    // Un bit por cada 16 bytes del chunk
+    int bitmap_bytes = ALLOC_CHUNK_SIZE / 16 / 8;
+
+    output << "_go_alloc:" << endl;
+    if (gc_enabled()) {
+        output << "  movq _gc_live(%rip), %rax" << endl;
+        output << "  cmpq _gc_next(%rip), %rax" << endl;
+        output << "  jae 6f" << endl;
+    }
+    output << "0:" << endl;
+    output << "  incq _alloc_count(%rip)" << endl;
+    output << "  addq %rdi, _alloc_requested(%rip)" << endl;
+    output << "  leaq 23(%rdi), %rax" << endl;
+    output << "  andq $-16, %rax" << endl;
+    output << "  cmpq $" << ALLOC_SMALL_MAX << ", %rax" << endl;
+    output << "  ja 1f" << endl;
+    output << "  movq %rax, %rcx" << endl;
+    output << "  shrq $4, %rcx" << endl;
+    output << "  decq %rcx" << endl;
+    output << "  jmp 2f" << endl;
+    output << "1:" << endl;
+    output << "  cmpq $" << ALLOC_MEDIUM_MAX << ", %rax" << endl;
+    output << "  ja 5f" << endl;
+    // Mediano: se redondea a la potencia de 2 siguiente
+    output << "  leaq -1(%rax), %rcx" << endl;
+    output << "  bsrq %rcx, %rcx" << endl;
+    output << "  incl %ecx" << endl;
+    output << "  movl $1, %eax" << endl;
+    output << "  shlq %cl, %rax" << endl;
+    output << "  addl $" << medium_base << ", %ecx" << endl;
+    // %rax = tamaño del bloque, %rcx = clase
+    output << "2:" << endl;
+    output << "  addq %rax, _gc_live(%rip)" << endl;
+    output << "  leaq _alloc_free(%rip), %rdx" << endl;
+    output << "  leaq (%rdx,%rcx,8), %rdx" << endl;
+    output << "  movq (%rdx), %rcx" << endl;
+    output << "  testq %rcx, %rcx" << endl;
+    output << "  jz 3f" << endl;
+    output << "  movq (%rcx), %rsi" << endl;
+    output << "  movq %rsi, (%rdx)" << endl;
+    output << "  andq $-3, -8(%rcx)" << endl;
+    output << "  movq %rcx, %rax" << endl;
+    output << "  ret" << endl;
+    output << "3:" << endl;
+    output << "  movq _alloc_cur(%rip), %rcx" << endl;
+    output << "  leaq (%rcx,%rax), %rdx" << endl;
+    output << "  cmpq _alloc_end(%rip), %rdx" << endl;
+    output << "  ja 4f" << endl;
+    output << "  movq %rdx, _alloc_cur(%rip)" << endl;
+    output << "  movq %rax, (%rcx)" << endl;
+    output << "  movq _alloc_base(%rip), %rsi" << endl;
+    output << "  movq %rcx, %rdx" << endl;
+    output << "  subq %rsi, %rdx" << endl;
+    output << "  shrq $4, %rdx" << endl;
+    output << "  btsq %rdx, (%rsi)" << endl;
+    output << "  leaq 8(%rcx), %rax" << endl;
+    output << "  ret" << endl;
+    output << "4:" << endl;
+    output << "  pushq %rax" << endl;
+    output << "  movq $" << ALLOC_CHUNK_SIZE << ", %rsi" << endl;
+    output << "  call _alloc_map" << endl;
+    output << "  movq %rax, _alloc_base(%rip)" << endl;
+    output << "  leaq " << bitmap_bytes << "(%rax), %rcx" << endl;
+    output << "  movq %rcx, _alloc_cur(%rip)" << endl;
+    output << "  leaq " << ALLOC_CHUNK_SIZE << "(%rax), %rsi" << endl;
+    output << "  movq %rsi, _alloc_end(%rip)" << endl;
+    output << "  movq %rax, %rdi" << endl;
+    output << "  xorl %edx, %edx" << endl;
+    output << "  call _alloc_register" << endl;
+    output << "  popq %rax" << endl;
+    output << "  jmp 3b" << endl;
+    output << "5:" << endl;
+    output << "  addq $4095, %rax" << endl;
+    output << "  andq $-4096, %rax" << endl;
+    output << "  addq %rax, _gc_live(%rip)" << endl;
+    output << "  pushq %rax" << endl;
+    output << "  movq %rax, %rsi" << endl;
+    output << "  call _alloc_map" << endl;
+    output << "  popq %rsi" << endl;
+    output << "  movq %rsi, (%rax)" << endl;
+    output << "  orq $1, (%rax)" << endl;
+    output << "  movq %rax, %rdi" << endl;
+    output << "  addq %rax, %rsi" << endl;
+    output << "  movl $1, %edx" << endl;
+    output << "  call _alloc_register" << endl;
+    output << "  leaq 8(%rdi), %rax" << endl;
+    output << "  ret" << endl;
+    if (gc_enabled()) {
+        // Con el marco armado, _gc_collect encuentra la dirección de retorno al
+        // helper que pidió memoria y desde ahí recorre la cadena de %rbp
+        output << "6:" << endl;
+        output << "  pushq %rbp" << endl;
+        output << "  movq %rsp, %rbp" << endl;
+        output << "  pushq %rdi" << endl;
+        output << "  subq $8, %rsp" << endl;
+        output << "  call _gc_collect" << endl;
+        output << "  addq $8, %rsp" << endl;
+        output << "  popq %rdi" << endl;
+        output << "  popq %rbp" << endl;
+        output << "  jmp 0b" << endl;
+    }
+
+    // %rdi = puntero devuelto por _go_alloc (o nulo)
+    output << "_go_free:" << endl;
+    output << "  testq %rdi, %rdi" << endl;
+    output << "  jz 9f" << endl;
+    output << "  incq _alloc_freed(%rip)" << endl;
+    output << "  movq -8(%rdi), %rax" << endl;
+    output << "  testb $1, %al" << endl;
+    output << "  jnz 3f" << endl;
+    output << "  andq $-16, %rax" << endl;
+    output << "  subq %rax, _gc_live(%rip)" << endl;
+    output << "  orq $2, -8(%rdi)" << endl;
+    output << "  cmpq $" << ALLOC_SMALL_MAX << ", %rax" << endl;
+    output << "  ja 1f" << endl;
+    output << "  shrq $4, %rax" << endl;
+    output << "  decq %rax" << endl;
+    output << "  jmp 2f" << endl;
+    output << "1:" << endl;
+    output << "  bsrq %rax, %rax" << endl;
+    output << "  addq $" << medium_base << ", %rax" << endl;
+    output << "2:" << endl;
+    output << "  leaq _alloc_free(%rip), %rdx" << endl;
+    output << "  movq (%rdx,%rax,8), %rcx" << endl;
+    output << "  movq %rcx, (%rdi)" << endl;
+    output << "  movq %rdi, (%rdx,%rax,8)" << endl;
+    output << "  ret" << endl;
+    // Grande: su entrada de _alloc_chunks se reemplaza por la última
+    output << "3:" << endl;
+    output << "  andq $-16, %rax" << endl;
+    output << "  subq %rax, _gc_live(%rip)" << endl;
+    output << "  subq %rax, _alloc_mapped(%rip)" << endl;
+    output << "  subq $8, %rdi" << endl;
+    output << "  leaq _alloc_chunks(%rip), %rdx" << endl;
+    output << "  movq _alloc_nchunks(%rip), %rcx" << endl;
+    output << "  decq %rcx" << endl;
+    output << "  movq %rcx, _alloc_nchunks(%rip)" << endl;
+    output << "  leaq (%rcx,%rcx,2), %rcx" << endl;
+    output << "  leaq (%rdx,%rcx,8), %rcx" << endl;
+    output << "4:" << endl;
+    output << "  cmpq %rdi, (%rdx)" << endl;
+    output << "  je 5f" << endl;
+    output << "  addq $24, %rdx" << endl;
+    output << "  jmp 4b" << endl;
+    output << "5:" << endl;
+    for (int at : {0, 8, 16}) {
+        output << "  movq " << at << "(%rcx), %rsi" << endl;
+        output << "  movq %rsi, " << at << "(%rdx)" << endl;
+    }
+    output << "  movq %rax, %rsi" << endl;
+    output << "  movl $11, %eax" << endl; // munmap
+    output << "  syscall" << endl;
+    output << "9:" << endl;
+    output << "  ret" << endl;
+
+    // Anota en _alloc_chunks la región [%rdi, %rsi) (%rdx = 1 si es un bloque grande)
+    output << "_alloc_register:" << endl;
+    output << "  movq _alloc_nchunks(%rip), %rax" << endl;
+    output << "  cmpq $" << ALLOC_MAX_CHUNKS << ", %rax" << endl;
+    output << "  jae _alloc_oom" << endl;
+    output << "  leaq (%rax,%rax,2), %rcx" << endl;
+    output << "  leaq _alloc_chunks(%rip), %r8" << endl;
+    output << "  leaq (%r8,%rcx,8), %rcx" << endl;
+    output << "  movq %rdi, (%rcx)" << endl;
+    output << "  movq %rsi, 8(%rcx)" << endl;
+    output << "  movq %rdx, 16(%rcx)" << endl;
+    output << "  incq %rax" << endl;
+    output << "  movq %rax, _alloc_nchunks(%rip)" << endl;
+    output << "  ret" << endl;
+
+    // mmap anónimo de %rsi bytes; si el sistema no da memoria, el programa termina
+    output << "_alloc_map:" << endl;
+    output << "  addq %rsi, _alloc_mapped(%rip)" << endl;
+    output << "  movl $9, %eax" << endl;
+    output << "  xorl %edi, %edi" << endl;
+    output << "  movl $3, %edx" << endl;   // PROT_READ | PROT_WRITE
+    output << "  movl $34, %r10d" << endl; // MAP_PRIVATE | MAP_ANONYMOUS
+    output << "  movq $-1, %r8" << endl;
+    output << "  xorl %r9d, %r9d" << endl;
+    output << "  syscall" << endl;
+    output << "  cmpq $-4096, %rax" << endl;
+    output << "  ja _alloc_oom" << endl;
+    output << "  ret" << endl;
+    output << "_alloc_oom:" << endl;
+    if (needs_output_buffer) output << "  call _out_flush" << endl;
+    output << "  movl $1, %eax" << endl;
+    output << "  movl $2, %edi" << endl;
+    output << "  leaq _alloc_oom_msg(%rip), %rsi" << endl;
+    output << "  movl $_alloc_oom_len, %edx" << endl;
+    output << "  syscall" << endl;
+    output << "  movl $231, %eax" << endl; // exit_group
+    output << "  movl $2, %edi" << endl;
+    output << "  syscall" << endl;
+
+    if (gc_enabled()) generate_gc_runtime();
+
+    if (options.alloc_stats) {
+        output << "_alloc_report:" << endl;
+        output << "  pushq %rbp" << endl;
+        output << "  movq %rsp, %rbp" << endl;
+        output << "  andq $-16, %rsp" << endl;
+        output << "  subq $8, %rsp" << endl;
+        output << "  pushq _gc_count(%rip)" << endl;
+        output << "  movl $2, %edi" << endl;
+        output << "  leaq _alloc_stats_fmt(%rip), %rsi" << endl;
+        output << "  movq _alloc_count(%rip), %rdx" << endl;
+        output << "  movq _alloc_requested(%rip), %rcx" << endl;
+        output << "  movq _alloc_freed(%rip), %r8" << endl;
+        output << "  movq _alloc_mapped(%rip), %r9" << endl;
+        output << "  xorl %eax, %eax" << endl;
+        output << "  call dprintf@PLT" << endl;
+        output << "  leave" << endl;
+        output << "  ret" << endl;
+    }
+
+    output << ".section .rodata" << endl;
+    output << "_alloc_oom_msg: .ascii \"fatal error: runtime: out of memory\\n\"" << endl;
+    output << "_alloc_oom_len = . - _alloc_oom_msg" << endl;
+    output << "_alloc_stats_fmt: .string \"alloc: %ld reservas (%ld bytes), %ld liberadas, %ld bytes mapeados, "
+           << "%ld recolecciones\\n\"" << endl;
+    output << ".data" << endl;
+    output << ".align 8" << endl;
+    // Se recolecta cuando lo vivo llega a _gc_next
+    output << "_gc_next: .quad " << options.gc_heap_min << endl;
+    output << ".bss" << endl;
+    output << ".align 8" << endl;
+    output << "_alloc_free: .zero " << classes * 8 << endl;
+    output << "_alloc_chunks: .zero " << ALLOC_MAX_CHUNKS * 24 << endl;
+    for (string name : {"_alloc_nchunks", "_alloc_base", "_alloc_cur", "_alloc_end", "_alloc_count",
+                        "_alloc_requested", "_alloc_freed", "_alloc_mapped", "_gc_live", "_gc_count"}) {
+        output << name << ": .zero 8" << endl;
+    }
+    output << ".text" << endl;
+}
+
+// Recolector mark-sweep, sin mover nada. Las raíces son los slots de la pila que
+// guardan el puntero de un string: en cada llamada que puede llegar a _go_alloc
+// (helpers que reservan y funciones del programa) hay una etiqueta en la dirección
+// de retorno, y _gc_maps tiene por cada una los offsets respecto de %rbp de esos
+// slots: variables visibles, campos string de structs y temporales de la pila.
+// Desde el marco de _go_alloc se sigue la cadena de %rbp: la dirección de retorno
+// de cada marco identifica el sitio, y el %rbp guardado es el marco que lo contiene;
+// la primera dirección desconocida es la de la libc que llamó a main.
+// Un slot puede tener basura (una variable aún sin asignar): solo se marca si apunta
+// dentro de un bloque ocupado de _alloc_chunks. Los strings no contienen punteros,
+// así que marcar es solo recorrer las raíces. El barrido devuelve a las listas los
+// bloques sin marca, y el próximo umbral es el doble de lo que sobrevivió (al menos
+// -fgc-heap-min=N bytes)
+void GoCodeGen::generate_gc_runtime() {
+    int bitmap_bytes = ALLOC_CHUNK_SIZE / 16 / 8;
+
+    output << "_gc_collect:" << endl;
+    for (string reg : {"%rbx", "%r12", "%r13", "%r14", "%r15"}) output << "  pushq " << reg << endl;
+    output << "  incq _gc_count(%rip)" << endl;
+    output << "  movq %rbp, %r12" << endl;
+    // %r12: marco cuya dirección de retorno se busca en _gc_maps
+    output << "1:" << endl;
+    output << "  movq 8(%r12), %rax" << endl;
+    output << "  leaq _gc_maps(%rip), %rbx" << endl;
+    output << "2:" << endl;
+    output << "  movq (%rbx), %rcx" << endl;
+    output << "  testq %rcx, %rcx" << endl;
+    output << "  jz " << (global_roots.empty() ? "5f" : "14f") << endl;
+    output << "  cmpq %rax, %rcx" << endl;
+    output << "  je 3f" << endl;
+    output << "  movq 8(%rbx), %rcx" << endl;
+    output << "  leaq 16(%rbx,%rcx,8), %rbx" << endl;
+    output << "  jmp 2b" << endl;
+    output << "3:" << endl;
+    output << "  movq (%r12), %r12" << endl;
+    output << "  movq 8(%rbx), %r13" << endl;
+    output << "  leaq 16(%rbx), %r14" << endl;
+    output << "4:" << endl;
+    output << "  testq %r13, %r13" << endl;
+    output << "  jz 1b" << endl;
+    output << "  movq (%r14), %rax" << endl;
+    output << "  movq (%r12,%rax), %rdi" << endl;
+    output << "  call _gc_mark" << endl;
+    output << "  addq $8, %r14" << endl;
+    output << "  decq %r13" << endl;
+    output << "  jmp 4b" << endl;
+    // Las globales con strings son raíces siempre: _gc_globals tiene sus direcciones
+    if (!global_roots.empty()) {
+        output << "14:" << endl;
+        output << "  leaq _gc_globals(%rip), %r14" << endl;
+        output << "  movq (%r14), %r13" << endl;
+        output << "15:" << endl;
+        output << "  testq %r13, %r13" << endl;
+        output << "  jz 5f" << endl;
+        output << "  addq $8, %r14" << endl;
+        output << "  movq (%r14), %rax" << endl;
+        output << "  movq (%rax), %rdi" << endl;
+        output << "  call _gc_mark" << endl;
+        output << "  decq %r13" << endl;
+        output << "  jmp 15b" << endl;
+    }
+
+    // Barrido. %r12 = índice en _alloc_chunks, %rbx = su entrada
+    output << "5:" << endl;
+    output << "  xorl %r12d, %r12d" << endl;
+    output << "6:" << endl;
+    output << "  cmpq _alloc_nchunks(%rip), %r12" << endl;
+    output << "  jae 12f" << endl;
+    output << "  leaq (%r12,%r12,2), %rax" << endl;
+    output << "  leaq _alloc_chunks(%rip), %rbx" << endl;
+    output << "  leaq (%rbx,%rax,8), %rbx" << endl;
+    output << "  cmpq $0, 16(%rbx)" << endl;
+    output << "  jne 10f" << endl;
+    // Chunk: sus bloques están seguidos; un encabezado en cero es la parte sin usar
+    output << "  movq (%rbx), %r13" << endl;
+    output << "  addq $" << bitmap_bytes << ", %r13" << endl;
+    output << "  movq 8(%rbx), %r14" << endl;
+    output << "7:" << endl;
+    output << "  cmpq %r14, %r13" << endl;
+    output << "  jae 9f" << endl;
+    output << "  movq (%r13), %rax" << endl;
+    output << "  testq %rax, %rax" << endl;
+    output << "  jz 9f" << endl;
+    output << "  movq %rax, %r15" << endl;
+    output << "  andq $-16, %r15" << endl;
+    output << "  testb $4, %al" << endl;
+    output << "  jz 8f" << endl;
+    output << "  andq $-5, (%r13)" << endl;
+    output << "  addq %r15, %r13" << endl;
+    output << "  jmp 7b" << endl;
+    output << "8:" << endl;
+    output << "  testb $2, %al" << endl;
+    output << "  jnz 11f" << endl;
+    output << "  leaq 8(%r13), %rdi" << endl;
+    output << "  call _go_free" << endl;
+    output << "11:" << endl;
+    output << "  addq %r15, %r13" << endl;
+    output << "  jmp 7b" << endl;
+    output << "9:" << endl;
+    output << "  incq %r12" << endl;
+    output << "  jmp 6b" << endl;
+    // Bloque grande: si no tiene marca, _go_free pone la última entrada en su lugar
+    output << "10:" << endl;
+    output << "  movq (%rbx), %rdi" << endl;
+    output << "  testb $4, (%rdi)" << endl;
+    output << "  jz 13f" << endl;
+    output << "  andq $-5, (%rdi)" << endl;
+    output << "  incq %r12" << endl;
+    output << "  jmp 6b" << endl;
+    output << "13:" << endl;
+    output << "  addq $8, %rdi" << endl;
+    output << "  call _go_free" << endl;
+    output << "  jmp 6b" << endl;
+    output << "12:" << endl;
+    output << "  movq _gc_live(%rip), %rax" << endl;
+    output << "  addq %rax, %rax" << endl;
+    output << "  movq $" << options.gc_heap_min << ", %rcx" << endl;
+    output << "  cmpq %rcx, %rax" << endl;
+    output << "  cmovb %rcx, %rax" << endl;
+    output << "  movq %rax, _gc_next(%rip)" << endl;
+    for (string reg : {"%r15", "%r14", "%r13", "%r12", "%rbx"}) output << "  popq " << reg << endl;
+    output << "  ret" << endl;
+
+    // %rdi = valor de un slot raíz. Se busca el bloque que contiene el último byte
+    // antes del puntero, así una vista que termina justo al final de su bloque (o
+    // una vacía al principio) sigue siendo de ese bloque
+    output << "_gc_mark:" << endl;
+    output << "  leaq -1(%rdi), %rax" << endl;
+    output << "  movq _alloc_nchunks(%rip), %rcx" << endl;
+    output << "  leaq _alloc_chunks(%rip), %rdx" << endl;
+    output << "1:" << endl;
+    output << "  testq %rcx, %rcx" << endl;
+    output << "  jz 9f" << endl;
+    output << "  cmpq (%rdx), %rax" << endl;
+    output << "  jb 2f" << endl;
+    output << "  cmpq 8(%rdx), %rax" << endl;
+    output << "  jb 3f" << endl;
+    output << "2:" << endl;
+    output << "  addq $24, %rdx" << endl;
+    output << "  decq %rcx" << endl;
+    output << "  jmp 1b" << endl;
+    output << "3:" << endl;
+    output << "  movq (%rdx), %rsi" << endl;
+    output << "  cmpq $0, 16(%rdx)" << endl;
+    output << "  jne 6f" << endl;
+    // En un chunk: el último bit de inicio en o antes del gránulo de 16 bytes de %rax
+    output << "  movq %rax, %rcx" << endl;
+    output << "  subq %rsi, %rcx" << endl;
+    output << "  shrq $4, %rcx" << endl;
+    output << "  movq %rcx, %r8" << endl;
+    output << "  shrq $6, %r8" << endl;
+    output << "  andl $63, %ecx" << endl;
+    output << "  xorl $63, %ecx" << endl;
+    output << "  movq $-1, %r9" << endl;
+    output << "  shrq %cl, %r9" << endl;
+    output << "  andq (%rsi,%r8,8), %r9" << endl;
+    output << "  jnz 5f" << endl;
+    output << "4:" << endl;
+    output << "  decq %r8" << endl;
+    output << "  js 9f" << endl;
+    output << "  movq (%rsi,%r8,8), %r9" << endl;
+    output << "  testq %r9, %r9" << endl;
+    output << "  jz 4b" << endl;
+    output << "5:" << endl;
+    output << "  bsrq %r9, %r9" << endl;
+    output << "  shlq $6, %r8" << endl;
+    output << "  addq %r9, %r8" << endl;
+    output << "  shlq $4, %r8" << endl;
+    output << "  addq %r8, %rsi" << endl;
+    // %rsi = inicio del bloque; uno libre o que no llega hasta %rax no se marca
+    output << "6:" << endl;
+    output << "  movq (%rsi), %rcx" << endl;
+    output << "  testb $2, %cl" << endl;
+    output << "  jnz 9f" << endl;
+    output << "  andq $-16, %rcx" << endl;
+    output << "  addq %rsi, %rcx" << endl;
+    output << "  cmpq %rcx, %rax" << endl;
+    output << "  jae 9f" << endl;
+    output << "  orq $4, (%rsi)" << endl;
+    output << "9:" << endl;
+    output << "  ret" << endl;
+
+    // Sitios de llamada: dirección de retorno, cantidad de slots y sus offsets
+    output << ".data" << endl;
+    output << ".align 8" << endl;
+    output << "_gc_maps:" << endl;
+    for (auto& site : gc_sites) {
+        output << "  .quad " << site.label << ", " << site.offsets.size();
+        for (int offset : site.offsets) output << ", " << offset;
+        output << endl;
+    }
+    output << "  .quad 0" << endl;
+    if (!global_roots.empty()) {
+        output << "_gc_globals:" << endl;
+        output << "  .quad " << global_roots.size();
+        for (int offset : global_roots) output << ", " << global_address(offset);
+        output << endl;
+    }
+    output << ".text" << endl;
+}
+
 void GoCodeGen::generate_string_literals() {
     for (const auto& kv : string_literals) {
+        // Los literales que quedaron dentro de una concatenación plegada no se emiten
+        if (!used_literals.count(kv.first)) continue;
         string val = kv.first;
         size_t pos = 0;
         while ((pos = val.find('\\', pos)) != std::string::npos) {
@@ -77,102 +1021,447 @@ void GoCodeGen::generate_string_literals() {
 }
 
 void GoCodeGen::generate_runtime_helpers() {
-    if (!needs_string_concat && !needs_string_compare) {
+    bool needs_alloc = needs_string_concat || needs_string_concat_n || needs_string_append || report_allocs();
+    if (!needs_alloc && !needs_string_compare && !needs_bounds_checks && !needs_divide_check &&
+        !needs_output_buffer) {
         return; 
     }
 
     output << endl << "# --- Funciones de Ayuda para Runtime (Generadas Condicionalmente) ---" << endl;
 
+    // Reserva desde un helper; 'roots' son los slots de su marco con punteros que
+    // siguen en uso después (las raíces si la reserva dispara el recolector)
+    auto call_alloc = [&](const string& name, const vector<int>& roots) {
+        output << "  call _go_alloc" << endl;
+        if (!gc_enabled()) return;
+        output << "_gc_site_" << name << ":" << endl;
+        gc_sites.push_back({"_gc_site_" + name, roots});
+    };
+
+    // Los strings llegan como (puntero, largo): a en %rdi:%rsi y b en %rdx:%rcx
     if (this->needs_string_concat) {
+        // Una sola reserva y dos memcpy; el resultado vuelve en %rax:%rdx. La entrada
+        // _into recibe un buffer del marco del llamador en %r8 y su tamaño en %r9: si
+        // el resultado entra se escribe ahí sin reservar
         output << "_concat_strings:" << endl;
+        output << "  xorl %r9d, %r9d" << endl;
+        output << "_concat_strings_into:" << endl;
         output << "  pushq %rbp" << endl;
         output << "  movq %rsp, %rbp" << endl;
-        output << "  subq $16, %rsp # Espacio para guardar args" << endl;
+        output << "  subq $32, %rsp" << endl;
         output << "  movq %rdi, -8(%rbp)" << endl;
         output << "  movq %rsi, -16(%rbp)" << endl;
-        output << "  call strlen@PLT" << endl;
-        output << "  pushq %rax" << endl;
-        output << "  movq -16(%rbp), %rdi" << endl;
-        output << "  call strlen@PLT" << endl;
-        output << "  popq %rcx" << endl;
-        output << "  addq %rcx, %rax" << endl;
-        output << "  incq %rax" << endl;
+        output << "  movq %rdx, -24(%rbp)" << endl;
+        output << "  movq %rcx, -32(%rbp)" << endl;
+        output << "  leaq (%rsi,%rcx), %rdi" << endl;
+        output << "  movq %r8, %rax" << endl;
+        output << "  cmpq %r9, %rdi" << endl;
+        output << "  jb 1f" << endl;
+        call_alloc("concat", {-8, -24});
+        output << "1:" << endl;
         output << "  movq %rax, %rdi" << endl;
-        output << "  call malloc@PLT" << endl;
         output << "  movq -8(%rbp), %rsi" << endl;
+        output << "  movq -16(%rbp), %rdx" << endl;
+        output << "  call memcpy@PLT" << endl;
+        output << "  movq %rax, -8(%rbp)" << endl;
         output << "  movq %rax, %rdi" << endl;
-        output << "  call strcpy@PLT" << endl;
-        output << "  movq -16(%rbp), %rsi" << endl;
+        output << "  addq -16(%rbp), %rdi" << endl;
+        output << "  movq -24(%rbp), %rsi" << endl;
+        output << "  movq -32(%rbp), %rdx" << endl;
+        output << "  call memcpy@PLT" << endl;
+        output << "  movq -8(%rbp), %rax" << endl;
+        output << "  movq -16(%rbp), %rdx" << endl;
+        output << "  addq -32(%rbp), %rdx" << endl;
+        output << "  leave" << endl;
+        output << "  ret" << endl;
+    }
+
+    if (this->needs_bounds_checks || this->needs_divide_check) {
+        // Destinos de los saltos de los chequeos de rango y de divisor cero: no vuelven. El índice (o a y
+        // b) y el largo llegan en los registros que usó la comparación (%rax, %rcx y
+        // %rdx); la pila se realinea porque se llega desde cualquier profundidad.
+        // _panic_slice_high es b > largo y _panic_slice_low es a > b
+        output << "_panic_index:" << endl;
+        output << "  andq $-16, %rsp" << endl;
+        output << "  movq %rdx, %rcx" << endl;
+        output << "  movq %rax, %rdx" << endl;
+        output << "  leaq panic_index_fmt(%rip), %rsi" << endl;
+        output << "  leaq panic_index_neg_fmt(%rip), %rdi" << endl;
+        output << "  jmp 1f" << endl;
+        output << "_panic_slice_high:" << endl;
+        output << "  andq $-16, %rsp" << endl;
+        output << "  xchgq %rcx, %rdx" << endl;
+        output << "  leaq panic_slice_high_fmt(%rip), %rsi" << endl;
+        output << "  leaq panic_slice_high_neg_fmt(%rip), %rdi" << endl;
+        output << "  jmp 1f" << endl;
+        output << "_panic_slice_low:" << endl;
+        output << "  andq $-16, %rsp" << endl;
+        output << "  movq %rax, %rdx" << endl;
+        output << "  leaq panic_slice_low_fmt(%rip), %rsi" << endl;
+        output << "  leaq panic_slice_low_neg_fmt(%rip), %rdi" << endl;
+        output << "  jmp 1f" << endl;
+        output << "_panic_divide:" << endl;
+        output << "  andq $-16, %rsp" << endl;
+        output << "  xorl %edx, %edx" << endl;
+        output << "  leaq panic_divide_fmt(%rip), %rsi" << endl;
+        output << "1:" << endl;
+        output << "  testq %rdx, %rdx" << endl;
+        output << "  cmovsq %rdi, %rsi" << endl;
+        // Lo impreso hasta aquí sale antes que el mensaje, también cuando fmt.Println
+        // usa printf y stdout comparte destino con stderr
+        for (string reg : {"%rsi", "%rdx", "%rcx", "%r8"}) output << "  pushq " << reg << endl;
+        if (needs_output_buffer) {
+            output << "  call _out_flush" << endl;
+        } else {
+            output << "  xorl %edi, %edi" << endl;
+            output << "  call fflush@PLT" << endl;
+        }
+        for (string reg : {"%r8", "%rcx", "%rdx", "%rsi"}) output << "  popq " << reg << endl;
+        output << "  movl $2, %edi" << endl;
+        output << "  xorl %eax, %eax" << endl;
+        output << "  call dprintf@PLT" << endl;
+        output << "  movl $2, %edi" << endl;
+        output << "  call exit@PLT" << endl;
+    }
+
+    if (this->needs_string_concat_n) {
+        // %rdi apunta a n pares (puntero, largo) y %rsi es n (al menos 3); _into
+        // recibe el buffer del marco en %rdx y su tamaño en %rcx
+        output << "_concat_strings_n:" << endl;
+        output << "  xorl %ecx, %ecx" << endl;
+        output << "_concat_strings_n_into:" << endl;
+        output << "  pushq %rbp" << endl;
+        output << "  movq %rsp, %rbp" << endl;
+        output << "  pushq %rbx" << endl;
+        output << "  pushq %r12" << endl;
+        output << "  pushq %r13" << endl;
+        output << "  pushq %r14" << endl;
+        output << "  movq %rdi, %rbx" << endl;
+        output << "  movq %rsi, %r12" << endl;
+        output << "  xorl %eax, %eax" << endl;
+        output << "1:" << endl;
+        output << "  addq 8(%rdi), %rax" << endl;
+        output << "  addq $16, %rdi" << endl;
+        output << "  decq %rsi" << endl;
+        output << "  jnz 1b" << endl;
+        output << "  movq %rax, %r13" << endl;
+        output << "  movq %rdx, %r14" << endl;
+        output << "  cmpq %rcx, %rax" << endl;
+        output << "  jb 2f" << endl;
         output << "  movq %rax, %rdi" << endl;
-        output << "  call strcat@PLT" << endl;
+        call_alloc("concat_n", {});
+        output << "  movq %rax, %r14" << endl;
+        output << "2:" << endl;
+        output << "  movq %r14, %rdi" << endl;
+        output << "  movq (%rbx), %rsi" << endl;
+        output << "  movq 8(%rbx), %rdx" << endl;
+        output << "  addq %rdx, %r14" << endl;
+        output << "  call memcpy@PLT" << endl;
+        output << "  addq $16, %rbx" << endl;
+        output << "  decq %r12" << endl;
+        output << "  jnz 2b" << endl;
+        output << "  movq %r14, %rax" << endl;
+        output << "  subq %r13, %rax" << endl;
+        output << "  movq %r13, %rdx" << endl;
+        output << "  popq %r14" << endl;
+        output << "  popq %r13" << endl;
+        output << "  popq %r12" << endl;
+        output << "  popq %rbx" << endl;
+        output << "  popq %rbp" << endl;
+        output << "  ret" << endl;
+    }
+
+    if (this->needs_string_append) {
+        // Como _concat_strings, con la dirección de la capacidad del acumulador en %r8.
+        // Si el resultado entra, se copia b después de a en el mismo buffer; si no, se
+        // pide uno de 2 * largo (al menos 32) y se copian ambos
+        output << "_append_string:" << endl;
+        output << "  pushq %rbp" << endl;
+        output << "  movq %rsp, %rbp" << endl;
+        output << "  subq $48, %rsp" << endl;
+        output << "  movq %rdi, -8(%rbp)" << endl;
+        output << "  movq %rsi, -16(%rbp)" << endl;
+        output << "  movq %rdx, -24(%rbp)" << endl;
+        output << "  movq %rcx, -32(%rbp)" << endl;
+        output << "  leaq (%rsi,%rcx), %rax" << endl;
+        output << "  cmpq (%r8), %rax" << endl;
+        output << "  jbe 1f" << endl;
+        output << "  addq %rax, %rax" << endl;
+        output << "  movq $32, %rcx" << endl;
+        output << "  cmpq %rcx, %rax" << endl;
+        output << "  cmovb %rcx, %rax" << endl;
+        output << "  movq %rax, (%r8)" << endl;
+        output << "  movq %rax, %rdi" << endl;
+        call_alloc("append", {-8, -24});
+        output << "  movq %rax, %rdi" << endl;
+        output << "  movq -8(%rbp), %rsi" << endl;
+        output << "  movq %rax, -8(%rbp)" << endl;
+        output << "  movq -16(%rbp), %rdx" << endl;
+        output << "  call memcpy@PLT" << endl;
+        output << "1:" << endl;
+        output << "  movq -8(%rbp), %rdi" << endl;
+        output << "  addq -16(%rbp), %rdi" << endl;
+        output << "  movq -24(%rbp), %rsi" << endl;
+        output << "  movq -32(%rbp), %rdx" << endl;
+        output << "  call memcpy@PLT" << endl;
+        output << "  movq -8(%rbp), %rax" << endl;
+        output << "  movq -16(%rbp), %rdx" << endl;
+        output << "  addq -32(%rbp), %rdx" << endl;
         output << "  leave" << endl;
         output << "  ret" << endl;
     }
 
     if (this->needs_string_compare) {
-        output << "_compare_strings:" << endl;
-        output << "  call strcmp@PLT" << endl;
+        // Devuelve 1 si son iguales. Distinto largo o el mismo puntero (literales
+        // internados, vistas del mismo buffer) deciden sin mirar los bytes; si no,
+        // memcmp de la libc, que compara con SIMD
+        output << "_equal_strings:" << endl;
+        output << "  cmpq %rcx, %rsi" << endl;
+        output << "  jne 2f" << endl;
+        output << "  cmpq %rdx, %rdi" << endl;
+        output << "  je 1f" << endl;
+        output << "  testq %rsi, %rsi" << endl;
+        output << "  je 1f" << endl;
+        output << "  subq $8, %rsp" << endl;
+        output << "  movq %rsi, %rax" << endl;
+        output << "  movq %rdx, %rsi" << endl;
+        output << "  movq %rax, %rdx" << endl;
+        output << "  call memcmp@PLT" << endl;
+        output << "  addq $8, %rsp" << endl;
+        output << "  testl %eax, %eax" << endl;
+        output << "  sete %al" << endl;
+        output << "  movzbl %al, %eax" << endl;
+        output << "  ret" << endl;
+        output << "1:" << endl;
+        output << "  movl $1, %eax" << endl;
+        output << "  ret" << endl;
+        output << "2:" << endl;
+        output << "  xorl %eax, %eax" << endl;
         output << "  ret" << endl;
     }
+    if (needs_output_buffer) generate_output_runtime();
+    if (needs_alloc) generate_alloc_runtime();
     output << "# --- Fin de Funciones de Ayuda ---" << endl;
 }
 
-int GoCodeGen::calculate_stmt_size(Stmt* stmt) {
+// Bytes de pila que necesita una sentencia. Con reuse_slots, los bloques hermanos
+// (then/else, bloques anidados) comparten slots: al salir de un alcance sus variables
+// mueren y current_offset vuelve atrás, así que basta el máximo en vez de la suma.
+// Tipo (o struct) al que evalúa una expresión durante el cálculo del marco; el
+// offset no se usa
+// Solo las globales tienen offset durante el cálculo del marco
+VarInfo GoCodeGen::sizing_var(const string& name) {
+    for (auto scope = sizing_scopes.rbegin(); scope != sizing_scopes.rend(); ++scope) {
+        auto found = scope->find(name);
+        if (found != scope->end()) return found->second;
+    }
+    auto global = global_vars.find(name);
+    if (global != global_vars.end()) return global->second;
+    return {0, NOTYPE, ""};
+}
+
+VarInfo GoCodeGen::sizing_info_of(Exp* exp) {
+    if (auto lit = dynamic_cast<StructLiteralExp*>(exp)) return {0, NOTYPE, lit->typeName};
+    if (dynamic_cast<StringExp*>(exp) || dynamic_cast<SliceExp*>(exp)) return {0, TSTRING, ""};
+    if (auto bin = dynamic_cast<BinaryExp*>(exp)) {
+        if (bin->op == PLUS_OP) return sizing_info_of(bin->left);
+        return {0, NOTYPE, ""};
+    }
+    if (auto call = dynamic_cast<FunctionCallExp*>(exp)) {
+        if (!env.has_function(call->funcName)) return {0, NOTYPE, ""};
+        FuncInfo info = env.get_function(call->funcName);
+        return {0, info.return_type, info.return_struct};
+    }
+    if (auto id = dynamic_cast<IdentifierExp*>(exp)) {
+        return sizing_var(id->name);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(exp)) {
+        string owner = sizing_info_of(fa->object).struct_name;
+        if (owner.empty() || !env.has_struct(owner)) return {0, NOTYPE, ""};
+        StructInfo sinfo = env.get_struct(owner);
+        auto field = sinfo.fields.find(fa->field);
+        if (field != sinfo.fields.end()) return {0, field->second.type, field->second.struct_name};
+    }
+    return {0, NOTYPE, ""};
+}
+
+// Bytes de marco de una variable: un struct lo que mide, un string 16 y el resto 8
+int GoCodeGen::value_bytes(const VarInfo& info) {
+    if (!info.struct_name.empty() && env.has_struct(info.struct_name)) {
+        return frame_bytes(env.get_struct(info.struct_name).size);
+    }
+    return info.type == TSTRING ? 16 : 8;
+}
+
+// Piezas de una cadena de concatenaciones a + b + c (con cualquier agrupación)
+static void flatten_concat(Exp* e, vector<Exp*>& pieces) {
+    auto bin = dynamic_cast<BinaryExp*>(e);
+    if (bin && bin->op == PLUS_OP) {
+        flatten_concat(bin->left, pieces);
+        flatten_concat(bin->right, pieces);
+    } else {
+        pieces.push_back(e);
+    }
+}
+
+// s += e o s = s + e (+ ...) sobre la variable s
+static bool is_append_to(AssignStmt* s, string& name) {
+    auto id = dynamic_cast<IdentifierExp*>(s->lhs);
+    if (!id) return false;
+    name = id->name;
+    if (s->op == PLUS_ASSIGN_OP) return true;
+    auto bin = dynamic_cast<BinaryExp*>(s->rhs);
+    if (s->op != ASSIGN_OP || !bin || bin->op != PLUS_OP) return false;
+    vector<Exp*> pieces;
+    flatten_concat(bin, pieces);
+    auto first = dynamic_cast<IdentifierExp*>(pieces.front());
+    return first && first->name == name;
+}
+
+static void collect_loop_appends(Block* block, bool in_loop, set<string>& names) {
+    if (!block) return;
+    for (auto stmt : block->statements) {
+        string name;
+        if (auto s = dynamic_cast<AssignStmt*>(stmt)) {
+            if (in_loop && is_append_to(s, name)) names.insert(name);
+        } else if (auto s = dynamic_cast<IfStmt*>(stmt)) {
+            collect_loop_appends(s->thenBlock, in_loop, names);
+            collect_loop_appends(s->elseBlock, in_loop, names);
+        } else if (auto s = dynamic_cast<ForStmt*>(stmt)) {
+            collect_loop_appends(s->body, true, names);
+        } else if (auto s = dynamic_cast<BlockStmt*>(stmt)) {
+            collect_loop_appends(s->block, in_loop, names);
+        }
+    }
+}
+
+// Un acumulador de strings guarda, además del puntero y el largo, la capacidad del
+// buffer al que apunta (0 si el buffer no es suyo). s += e escribe en su lugar
+// después de los s.len bytes mientras haya capacidad y si no copia a un buffer del
+// doble, así que construir un string de n bytes cuesta O(n). Ningún otro string ve
+// esos bytes: las copias de s (t := s, un argumento) miran solo hasta su propio
+// largo, y el buffer viejo no se libera al crecer. Por eso el acumulador siempre es
+// un string válido y no hace falta materializarlo al salir del bucle. Cualquier
+// otra asignación a s pone la capacidad en 0. Los parámetros no son acumuladores.
+void GoCodeGen::find_string_builders(FuncDecl* decl) {
+    string_builders.clear();
+    stack_builders.clear();
+    if (options.string_builder) collect_loop_appends(decl->body, false, string_builders);
+    auto locals = escapes.local_vars.find(decl->name);
+    if (locals == escapes.local_vars.end()) return;
+    for (auto& name : string_builders) {
+        if (locals->second.count(name)) stack_builders.insert(name);
+    }
+}
+
+bool GoCodeGen::stack_builder(const string& name, Exp* init) {
+    auto str = dynamic_cast<StringExp*>(init);
+    return stack_builders.count(name) && (!init || (str && str->value.empty()));
+}
+
+int GoCodeGen::stack_buffer_of(Exp* e) {
+    auto found = stack_buffers.find(e);
+    if (found != stack_buffers.end()) return found->second;
+    auto temp = escapes.temp_buffers.find(e);
+    if (temp != escapes.temp_buffers.end()) return temp_area - (temp->second + 1) * options.stack_buffer;
+    return 0;
+}
+
+int GoCodeGen::calculate_function_size(FuncDecl* decl, bool reuse_slots) {
+    find_string_builders(decl);
+    sizing_scopes.push_back({});
+    for (auto& param : decl->params) {
+        VarInfo info = {0, NOTYPE, ""};
+        if (auto bt = dynamic_cast<BasicType*>(param.second)) info.type = ImpValue::get_basic_type(bt->typeName);
+        else if (auto id_type = dynamic_cast<IdentifierType*>(param.second)) info.struct_name = id_type->name;
+        sizing_scopes.back()[param.first] = info;
+    }
+    int size = calculate_block_size(decl->body, reuse_slots);
+    sizing_scopes.pop_back();
+    return size;
+}
+
+int GoCodeGen::calculate_stmt_size(Stmt* stmt, bool reuse_slots) {
     int size = 0;
     if (auto s = dynamic_cast<VarDecl*>(stmt)) {
+        VarInfo info = {0, NOTYPE, ""};
         if (auto id_type = dynamic_cast<IdentifierType*>(s->type)) {
-            if (env.has_struct(id_type->name)) {
-                size += env.get_struct(id_type->name).size * s->names.size();
-            }
-        } else {
-             size += s->names.size() * 8;
+            if (env.has_struct(id_type->name)) info.struct_name = id_type->name;
+        } else if (auto bt = dynamic_cast<BasicType*>(s->type)) {
+            info.type = ImpValue::get_basic_type(bt->typeName);
+        }
+        size += value_bytes(info) * s->names.size();
+        auto value_it = s->values.begin();
+        for (auto& name : s->names) {
+            Exp* value = value_it != s->values.end() ? *value_it++ : nullptr;
+            if (info.type == TSTRING && string_builders.count(name)) size += 8;
+            if (info.type == TSTRING && stack_builder(name, value)) size += options.stack_buffer;
+            if (escapes.var_buffers.count(value)) size += options.stack_buffer;
+            sizing_scopes.back()[name] = info;
         }
     } else if (auto s = dynamic_cast<ShortVarDecl*>(stmt)) {
-        // El código anterior era: size += s->identifiers.size() * 8;
-        // lo que asumía incorrectamente que toda variable declarada con := ocupa 8 bytes.
-        // El nuevo código inspecciona el tipo de la expresión para determinar el tamaño correcto.
+        // Cada variable ocupa lo que el valor al que se inicializa
         auto value_it = s->values.begin();
         for (const auto& id_name : s->identifiers) {
-            if (value_it != s->values.end()) {
-                Exp* value_exp = *value_it;
-                if (auto struct_lit = dynamic_cast<StructLiteralExp*>(value_exp)) {
-                    // Es un struct. Obtenemos su tamaño del entorno.
-                    if (env.has_struct(struct_lit->typeName)) {
-                        size += env.get_struct(struct_lit->typeName).size;
-                    } else {
-                        // Fallback por si el struct no se encuentra (no debería pasar)
-                        size += 8;
-                    }
-                } else {
-                    // No es un struct (es int, string, bool, etc.), asumimos 8 bytes.
-                    size += 8;
-                }
-                value_it++;
-            } else {
-                // Fallback en caso de que no coincidan identificadores y valores
-                size += 8;
-            }
+            Exp* value = value_it != s->values.end() ? *value_it++ : nullptr;
+            VarInfo info = value ? sizing_info_of(value) : VarInfo{0, NOTYPE, ""};
+            size += value_bytes(info);
+            if (info.type == TSTRING && string_builders.count(id_name)) size += 8;
+            if (info.type == TSTRING && stack_builder(id_name, value)) size += options.stack_buffer;
+            if (escapes.var_buffers.count(value)) size += options.stack_buffer;
+            sizing_scopes.back()[id_name] = info;
+        }
+    } else if (auto s = dynamic_cast<AssignStmt*>(stmt)) {
+        // p = T{...} se arma en un temporal si el literal lee el destino, y g = f() si
+        // g es global y el struct vuelve por memoria
+        auto lit = dynamic_cast<StructLiteralExp*>(s->rhs);
+        if (lit && env.has_struct(lit->typeName)) size += frame_bytes(env.get_struct(lit->typeName).size);
+        if (dynamic_cast<FunctionCallExp*>(s->rhs) && is_global_slot(sizing_var(lvalue_base(s->lhs)).offset)) {
+            string returned = sizing_info_of(s->rhs).struct_name;
+            if (!returned.empty() && struct_regs(returned) == 0) size += frame_bytes(env.get_struct(returned).size);
+        }
+    } else if (auto s = dynamic_cast<ReturnStmt*>(stmt)) {
+        // return T{...} de un struct chico se arma en un temporal antes de cargar %rax:%rdx
+        auto lit = dynamic_cast<StructLiteralExp*>(s->expression);
+        if (lit && env.has_struct(lit->typeName) && struct_regs(lit->typeName)) {
+            size += frame_bytes(env.get_struct(lit->typeName).size);
         }
-        // --- FIN DE LA CORRECCIÓN ---
     } else if (auto s = dynamic_cast<IfStmt*>(stmt)) {
-        if(s->thenBlock) size += calculate_block_size(s->thenBlock);
-        if (s->elseBlock) size += calculate_block_size(s->elseBlock);
+        int then_size = calculate_block_size(s->thenBlock, reuse_slots);
+        int else_size = calculate_block_size(s->elseBlock, reuse_slots);
+        size += reuse_slots ? max(then_size, else_size) : then_size + else_size;
     } else if (auto s = dynamic_cast<ForStmt*>(stmt)) {
-        if (s->init) size += calculate_stmt_size(s->init);
-        if (s->body) size += calculate_block_size(s->body);
+        sizing_scopes.push_back({});
+        if (s->init) size += calculate_stmt_size(s->init, reuse_slots);
+        if (s->body) size += calculate_block_size(s->body, reuse_slots);
+        sizing_scopes.pop_back();
+    } else if (auto s = dynamic_cast<BlockStmt*>(stmt)) {
+        size += calculate_block_size(s->block, reuse_slots);
     }
     return size;
 }
 
-int GoCodeGen::calculate_block_size(Block* block) {
-    int size = 0;
+// Las declaraciones de un bloque se acumulan en orden; una sentencia con bloques
+// anidados necesita además su propio espacio solo mientras se ejecuta
+int GoCodeGen::calculate_block_size(Block* block, bool reuse_slots) {
+    int live = 0, peak = 0;
     if (block) {
-        for(auto s : block->statements) size += calculate_stmt_size(s);
+        sizing_scopes.push_back({});
+        for (auto s : block->statements) {
+            int size = calculate_stmt_size(s, reuse_slots);
+            bool is_decl = dynamic_cast<VarDecl*>(s) || dynamic_cast<ShortVarDecl*>(s);
+            if (is_decl || !reuse_slots) {
+                live += size;
+                peak = max(peak, live);
+            } else {
+                peak = max(peak, live + size);
+            }
+        }
+        sizing_scopes.pop_back();
     }
-    return size;
+    return peak;
 }
 
-int GoCodeGen::calculate_stack_size(Program* p) { return 0; }
+int GoCodeGen::calculate_stack_size(Program*) { return 0; }
 
 void GoCodeGen::visit(Program* program) {
     for (auto func : program->functions) {
@@ -180,28 +1469,218 @@ void GoCodeGen::visit(Program* program) {
     }
 }
 
+//=== VARIABLES GLOBALES ===
+// El contenido se arma con los campos en el orden de los literales; generate_globals
+// lo ordena por offset. Los ceros no se anotan: los cubre el relleno
+bool GoCodeGen::constant_image(Exp* value, const VarInfo& info, int base, vector<pair<int, string>>& image,
+                               const map<string, Exp*>& known) {
+    if (!info.struct_name.empty()) {
+        auto lit = dynamic_cast<StructLiteralExp*>(value);
+        if (!lit || lit->typeName != info.struct_name) return false;
+        StructInfo sinfo = env.get_struct(info.struct_name);
+        vector<string> fields = literal_fields(lit, sinfo);
+        auto value_it = lit->values.begin();
+        for (size_t i = 0; i < lit->values.size(); i++, ++value_it) {
+            const FieldInfo& field = sinfo.fields.at(fields[i]);
+            VarInfo field_info = {0, field.type, field.struct_name};
+            if (!constant_image(*value_it, field_info, base + field.offset, image, known)) return false;
+        }
+        return true;
+    }
+    ConstValue c;
+    if (!eval_constant(value, known, c) || c.type != info.type) return false;
+    if (c.type == TSTRING && !c.text.empty()) {
+        image.push_back({base, ".quad " + string_label(c.text)});
+        image.push_back({base + 8, ".quad " + to_string(c.text.size())});
+    } else if (c.type == TBOOL && c.number) {
+        // Un byte alcanza también para una variable bool de 8 bytes: el resto es cero
+        image.push_back({base, ".byte 1"});
+    } else if (c.type == TINT && c.number) {
+        image.push_back({base, ".quad " + to_string(c.number)});
+    }
+    return true;
+}
+
+// Las globales se ubican en el orden en que se declaran. Un inicializador constante
+// (literales, operaciones entre ellos, len de un literal, structs literales de
+// constantes y globales anteriores así inicializadas) queda escrito en .data y el
+// arranque no hace nada por él; el resto se asigna en _go_init, en orden. Una global
+// solo se lee en compilación mientras no haya corrido ningún inicializador, que
+// podría haberla cambiado.
+list<Stmt*> GoCodeGen::layout_globals(Program* program) {
+    list<Stmt*> init;
+    map<string, Exp*> known;
+    const map<string, Exp*> none;
+    int offset = GLOBAL_BASE;
+    for (auto decl : program->globalVars) {
+        VarInfo info = {0, NOTYPE, ""};
+        int size = 8;
+        if (auto id_type = dynamic_cast<IdentifierType*>(decl->type)) {
+            info.struct_name = id_type->name;
+            size = env.get_struct(info.struct_name).size;
+        } else if (auto bt = dynamic_cast<BasicType*>(decl->type)) {
+            info.type = ImpValue::get_basic_type(bt->typeName);
+            if (info.type == TSTRING) size = 16;
+        }
+        auto value_it = decl->values.begin();
+        for (auto& name : decl->names) {
+            Exp* value = value_it != decl->values.end() ? *value_it++ : nullptr;
+            if (global_vars.count(name)) throw runtime_error("Redeclaración de la variable global '" + name + "'.");
+            GlobalVar global{"global_" + name, offset, frame_bytes(size), {}};
+            info.offset = offset;
+            env.add_var(name, offset, info.type, info.struct_name);
+            global_vars[name] = info;
+            if (!info.struct_name.empty()) string_words(info.struct_name, offset, global_roots);
+            else if (info.type == TSTRING) global_roots.push_back(offset);
+
+            if (value && !constant_image(value, info, 0, global.image, init.empty() ? known : none)) {
+                global.image.clear();
+                init.push_back(new AssignStmt(new IdentifierExp(name), clone_exp(value), ASSIGN_OP));
+            } else if (value && info.struct_name.empty()) {
+                known[name] = value;
+            }
+            globals.push_back(global);
+            offset += global.size;
+        }
+    }
+    return init;
+}
+
+bool GoCodeGen::is_global_slot(int offset) { return offset >= GLOBAL_BASE; }
+
+string GoCodeGen::global_address(int offset) {
+    auto it = upper_bound(globals.begin(), globals.end(), offset,
+                          [](int o, const GlobalVar& g) { return o < g.offset; });
+    const GlobalVar& global = *prev(it);
+    int delta = offset - global.offset;
+    return global.label + (delta ? "+" + to_string(delta) : "");
+}
+
+void GoCodeGen::generate_globals() {
+    bool data = false, bss = false;
+    for (auto& global : globals) {
+        if (global.image.empty()) continue;
+        if (!data) output << ".data" << endl;
+        data = true;
+        output << ".balign 8" << endl;
+        output << global.label << ":" << endl;
+        vector<pair<int, string>> image = global.image;
+        sort(image.begin(), image.end());
+        int at = 0;
+        for (auto& item : image) {
+            if (item.first > at) output << "  .zero " << item.first - at << endl;
+            output << "  " << item.second << endl;
+            at = item.first + (item.second.rfind(".byte", 0) == 0 ? 1 : 8);
+        }
+        if (global.size > at) output << "  .zero " << global.size - at << endl;
+    }
+    for (auto& global : globals) {
+        if (!global.image.empty()) continue;
+        if (!bss) output << ".bss" << endl;
+        bss = true;
+        output << ".balign 8" << endl;
+        output << global.label << ": .zero " << global.size << endl;
+    }
+    if (data || bss) output << ".text" << endl;
+}
+
+string GoCodeGen::frame_slot(int offset) {
+    if (is_global_slot(offset)) return global_address(offset) + "(%rip)";
+    if (!frame_omitted) return to_string(offset) + "(%rbp)";
+    // Sin 'pushq %rbp', %rsp queda 8 bytes por encima de donde estaría %rbp
+    // respecto de los argumentos de pila; los locales usan los mismos offsets negativos
+    return to_string(offset > 0 ? offset - 8 : offset) + "(%rsp)";
+}
+
+// Las funciones hoja (sin ninguna llamada) cuyos locales y temporales caben en los
+// 128 bytes de la red zone de System V no arman marco: direccionan todo respecto de
+// %rsp, que nunca se mueve, y los push/pop pasan a ser movs debajo de los locales.
+// Para saberlo se genera la función una vez descartando la salida.
 void GoCodeGen::visit(FuncDecl* decl) {
+    frame_omitted = false;
+    if (options.omit_frame_pointer && decl->name != "main") {
+        int saved_labels = label_counter;
+        size_t saved_sites = gc_sites.size();
+        ostringstream discard;
+        streambuf* saved_buffer = output.rdbuf(discard.rdbuf());
+        made_call = false;
+        max_stack_depth = 0;
+        try {
+            generate_function(decl);
+        } catch (...) {
+            output.rdbuf(saved_buffer);
+            throw;
+        }
+        output.rdbuf(saved_buffer);
+        label_counter = saved_labels;
+        gc_sites.resize(saved_sites);
+        frame_omitted = !made_call && frame_size + max_stack_depth <= RED_ZONE_SIZE;
+    }
+    generate_function(decl);
+
+    if (options.frame_report) {
+        int param_bytes = frame_size - env.get_function(decl->name).stack_size;
+        int unshared = calculate_function_size(decl, false) + param_bytes;
+        cerr << "  " << decl->name << ": " << frame_size << " bytes de locales y parámetros ("
+             << unshared << " sin compartir slots)";
+        if (frame_omitted) cerr << ", sin marco (red zone)";
+        else cerr << ", marco de " << ((frame_size + 15) & -16) << " bytes";
+        cerr << endl;
+    }
+}
+
+void GoCodeGen::generate_function(FuncDecl* decl) {
     current_epilogue_label = new_label();
+    current_entry_label = new_label();
+    current_function = decl;
+    find_string_builders(decl);
+
+    // Los parámetros que llegan en registros (y la dirección donde se escribe un
+    // struct devuelto por memoria) se guardan en el marco
+    FuncInfo info = env.get_function(decl->name);
+    bool has_sret = !info.return_struct.empty() && struct_regs(info.return_struct) == 0;
+    int stack_bytes;
+    vector<ArgSlot> slots = layout_args(info.param_types, info.param_structs, has_sret, stack_bytes);
+    frame_size = info.stack_size + (has_sret ? 8 : 0);
+    for (auto& slot : slots) {
+        if (slot.reg >= 0) frame_size += slot.regs * 8;
+    }
+    // Debajo de los locales, los buffers de las concatenaciones temporales
+    temp_area = -frame_size;
+    auto temps = escapes.temp_buffer_count.find(decl->name);
+    if (temps != escapes.temp_buffer_count.end()) frame_size += temps->second * options.stack_buffer;
+    stack_buffers.clear();
 
     output << ".globl " << decl->name << endl;
     output << decl->name << ":" << endl;
-    output << "  pushq %rbp" << endl;
-    output << "  movq %rsp, %rbp" << endl;
-
-    int stack_size = env.get_function(decl->name).stack_size;
-    // El 'pushq %rbp' ya desalinea la pila por 8 bytes.
-    // Necesitamos que el tamaño total restado a %rsp sea de la forma 16*N - 8
-    // para que la pila vuelva a estar alineada a 16 bytes.
-    // La forma más simple es redondear el tamaño necesario al múltiplo de 16 más cercano.
-    if (stack_size > 0) {
-        stack_size = (stack_size + 15) & -16; // Redondea hacia arriba al múltiplo de 16
-        output << "  subq $" << stack_size << ", %rsp" << endl;
+    if (!frame_omitted) {
+        output << "  pushq %rbp" << endl;
+        output << "  movq %rsp, %rbp" << endl;
+        // El 'pushq %rbp' ya desalinea la pila por 8 bytes.
+        // Necesitamos que el tamaño total restado a %rsp sea de la forma 16*N - 8
+        // para que la pila vuelva a estar alineada a 16 bytes.
+        // La forma más simple es redondear el tamaño necesario al múltiplo de 16 más cercano.
+        if (frame_size > 0) {
+            int stack_size = (frame_size + 15) & -16; // Redondea hacia arriba al múltiplo de 16
+            output << "  subq $" << stack_size << ", %rsp" << endl;
+        }
     }
 
     current_offset = 0;
+    stack_depth = 0;
+    pointer_temps.clear();
     env.add_level();
 
-    int param_offset = 16;
+    // Los parámetros llegan en %rdi..%r9 según layout_args; el resto quedó en la
+    // pila del llamador, por encima de la dirección de retorno
+    sret_slot = 0;
+    if (has_sret) {
+        current_offset -= 8;
+        sret_slot = current_offset;
+        output << "  movq %rdi, " << frame_slot(sret_slot) << endl;
+    }
+    auto slot_it = slots.begin();
+    current_param_offsets.clear();
     for (auto param : decl->params) {
         string param_name = param.first;
         Type* param_type_node = param.second;
@@ -215,9 +1694,20 @@ void GoCodeGen::visit(FuncDecl* decl) {
             struct_name = id_type->name;
         }
         
-        env.add_var(param_name, param_offset, param_type_enum, struct_name);
-        param_offset += 8;
+        const ArgSlot& slot = *slot_it++;
+        if (slot.reg >= 0) {
+            current_offset -= slot.regs * 8;
+            for (int r = 0; r < slot.regs; r++) {
+                output << "  movq " << ARG_REGS[slot.reg + r] << ", " << frame_slot(current_offset + 8 * r) << endl;
+            }
+            env.add_var(param_name, current_offset, param_type_enum, struct_name);
+            for (int r = 0; r < slot.regs; r++) current_param_offsets.push_back(current_offset + 8 * r);
+        } else {
+            env.add_var(param_name, 16 + slot.stack_offset, param_type_enum, struct_name);
+        }
     }
+    if (decl->name == "main" && needs_output_buffer) output << "  call _out_install" << endl;
+    output << current_entry_label << ":" << endl;
 
     if (decl->body) {
         decl->body->accept(this);
@@ -225,9 +1715,11 @@ void GoCodeGen::visit(FuncDecl* decl) {
 
     output << current_epilogue_label << ":" << endl;
     if (decl->name == "main") {
+        if (needs_output_buffer) output << "  call _out_flush" << endl;
+        if (report_allocs()) output << "  call _alloc_report" << endl;
         output << "  movq $0, %rax" << endl;
     }
-    output << "  leave" << endl;
+    if (!frame_omitted) output << "  leave" << endl;
     output << "  ret" << endl;
     
     env.remove_level();
@@ -235,50 +1727,111 @@ void GoCodeGen::visit(FuncDecl* decl) {
 
 void GoCodeGen::visit(Block* block) {
     env.add_level();
+    int scope_offset = current_offset;
     if(block) {
         for (auto stmt : block->statements) {
             stmt->accept(this);
         }
     }
+    // Las variables del bloque mueren aquí: sus slots quedan libres para los siguientes
+    current_offset = scope_offset;
     env.remove_level();
 }
 
 void GoCodeGen::visit(ExprStmt* stmt) { stmt->expression->accept(this); }
 
 void GoCodeGen::visit(AssignStmt* stmt) {
+    int struct_dest;
+    string struct_name;
+    if (struct_location(stmt->lhs, struct_dest, struct_name)) {
+        if (stmt->op != ASSIGN_OP) throw runtime_error("Operación no válida sobre un struct.");
+        // Si el literal lee el destino (p = Punto{p.y, p.x}) se arma en un temporal.
+        // Una global también, si una llamada del lado derecho puede verla a medio
+        // escribir: la de un campo del literal o la que escribe su resultado en ella
+        auto lit = dynamic_cast<StructLiteralExp*>(stmt->rhs);
+        auto call = dynamic_cast<FunctionCallExp*>(stmt->rhs);
+        set<string> used, called;
+        if (lit) collect_used_vars(lit, used);
+        bool temp = lit && used.count(lvalue_base(stmt->lhs));
+        if (is_global_slot(struct_dest) && (lit || (call && struct_regs(struct_name) == 0))) {
+            collect_called_functions(stmt->rhs, called);
+            temp = temp || calls_program_function(called);
+        }
+        if (temp) {
+            int size = env.get_struct(struct_name).size;
+            current_offset -= frame_bytes(size);
+            store_new_struct(stmt->rhs, current_offset, struct_name);
+            emit_copy(struct_dest, current_offset, size);
+            current_offset += frame_bytes(size);
+        } else {
+            store_struct_value(stmt->rhs, struct_dest, struct_name);
+        }
+        return;
+    }
+
+    int dest;
+    ImpVType dest_type;
+    int dest_size = 8;
+    bool builder = false;
     if (auto field_access = dynamic_cast<FieldAccessExp*>(stmt->lhs)) {
+        FieldInfo finfo;
+        field_location(field_access, dest, finfo);
+        dest_type = finfo.type;
+        dest_size = finfo.size;
+    } else if (auto id = dynamic_cast<IdentifierExp*>(stmt->lhs)) {
+        VarInfo info = env.lookup(id->name);
+        dest = info.offset;
+        dest_type = info.type;
+        if (dest_type == TSTRING) dest_size = 16;
+        builder = info.builder;
+    } else {
+        throw runtime_error("LHS de asignación debe ser una variable o campo de struct.");
+    }
+
+    string name;
+    if (builder && is_append_to(stmt, name)) {
+        // Se agrega todo lo que sigue a s en la cadena, concatenado de una vez
+        vector<Exp*> pieces;
+        flatten_concat(stmt->rhs, pieces);
+        if (stmt->op == ASSIGN_OP) pieces.erase(pieces.begin());
+        // Con += el lado derecho es una concatenación propia que solo se copia
+        generate_concat(pieces, stmt->op == PLUS_ASSIGN_OP ? stack_buffer_of(stmt->rhs) : 0);
+        emit_string_append(dest);
+        return;
+    }
+    if (stmt->op == PLUS_ASSIGN_OP && dest_type == TSTRING) {
+        // s += a + b es una sola concatenación de s, a y b
+        vector<Exp*> pieces = {stmt->lhs};
+        flatten_concat(stmt->rhs, pieces);
+        generate_concat(pieces);
+    } else if (stmt->op == ASSIGN_OP) {
         stmt->rhs->accept(this);
-        
-        IdentifierExp* obj_id = dynamic_cast<IdentifierExp*>(field_access->object);
-        if (!obj_id) throw runtime_error("Asignación solo a campos de variables de struct simples.");
-        
-        VarInfo var_info = env.lookup(obj_id->name);
-        StructInfo sinfo = env.get_struct(var_info.struct_name);
-        int field_offset = sinfo.offsets.at(field_access->field);
-        int total_offset = var_info.offset + field_offset;
-        
-        output << "  movq %rax, " << total_offset << "(%rbp)" << endl;
     } else {
-        if (auto id = dynamic_cast<IdentifierExp*>(stmt->lhs)) {
-            VarInfo info = env.lookup(id->name);
-            
-            if (stmt->op == PLUS_ASSIGN_OP && info.type == TSTRING) {
-                this->needs_string_concat = true; 
-                stmt->lhs->accept(this);
-                output << "  pushq %rax" << endl;
-                stmt->rhs->accept(this);
-                output << "  movq %rax, %rsi" << endl;
-                output << "  popq %rdi" << endl;
-                output << "  call _concat_strings" << endl;
-                output << "  movq %rax, " << info.offset << "(%rbp)" << endl;
-            } else {
-                stmt->rhs->accept(this);
-                output << "  movq %rax, " << info.offset << "(%rbp)" << endl;
-            }
-        } else {
-             throw runtime_error("LHS de asignación debe ser una variable o campo de struct.");
+        // x op= e: el lado derecho se evalúa primero y luego se opera sobre x
+        stmt->rhs->accept(this);
+        output << "  movq %rax, %rcx" << endl;
+        emit_load(dest, dest_size, "%rax");
+        switch (stmt->op) {
+            case PLUS_ASSIGN_OP: output << "  addq %rcx, %rax" << endl; break;
+            case MINUS_ASSIGN_OP: output << "  subq %rcx, %rax" << endl; break;
+            case MUL_ASSIGN_OP: output << "  imulq %rcx, %rax" << endl; break;
+            case DIV_ASSIGN_OP: emit_division(stmt->rhs, false); break;
+            case MOD_ASSIGN_OP: emit_division(stmt->rhs, true); break;
+            default: break;
         }
     }
+    emit_store(dest, dest_size);
+    if (builder) output << "  movq $0, " << frame_slot(dest + 16) << endl;
+}
+
+void GoCodeGen::emit_string_append(int offset) {
+    this->needs_string_append = true;
+    output << "  movq %rdx, %rcx" << endl;
+    output << "  movq %rax, %rdx" << endl;
+    emit_load(offset, 16, "%rdi", "%rsi");
+    output << "  leaq " << frame_slot(offset + 16) << ", %r8" << endl;
+    emit_call("_append_string");
+    emit_store(offset, 16);
 }
 
 void GoCodeGen::visit(ShortVarDecl* stmt) {
@@ -290,38 +1843,37 @@ void GoCodeGen::visit(ShortVarDecl* stmt) {
     auto val_it = stmt->values.begin();
     
     while (var_it != stmt->identifiers.end()) {
-        ImpValue val_info = (*val_it)->accept(this);
-        
-        if (val_info.type == TSTRING) {
-            current_offset -= 8;
-            env.add_var(*var_it, current_offset, TSTRING);
-            output << "  movq %rax, " << current_offset << "(%rbp)" << endl;
-        } 
-        else if (!val_info.struct_name.empty()) {
-            StructInfo sinfo = env.get_struct(val_info.struct_name);
-            current_offset -= sinfo.size;
-            env.add_var(*var_it, current_offset, NOTYPE, sinfo.name);
-            
-            vector<pair<string, int>> sorted_fields;
-            for(auto const& field_map_entry : sinfo.offsets) sorted_fields.push_back(field_map_entry);
-            sort(sorted_fields.begin(), sorted_fields.end(), [](const pair<string,int>& a, const pair<string,int>& b) { return a.second < b.second; });
-
-            StructLiteralExp* struct_lit = dynamic_cast<StructLiteralExp*>(*val_it);
-            auto value_node_it = struct_lit->values.begin();
-            for(const auto& field : sorted_fields) {
-                if (value_node_it != struct_lit->values.end()) {
-                    (*value_node_it)->accept(this);
-                    int total_offset = current_offset + field.second;
-                    output << "  movq %rax, " << total_offset << "(%rbp)" << endl;
-                    ++value_node_it;
-                }
-            }
-        } 
-        else {
-            current_offset -= 8;
-            env.add_var(*var_it, current_offset, val_info.type);
-            output << "  movq %rax, " << current_offset << "(%rbp)" << endl;
+        // Un struct se escribe directamente en el slot de la variable nueva
+        string struct_name = struct_type_of(*val_it);
+        if (!struct_name.empty()) {
+            int offset = current_offset - frame_bytes(env.get_struct(struct_name).size);
+            store_new_struct(*val_it, offset, struct_name);
+            current_offset = offset;
+            env.add_var(*var_it, current_offset, NOTYPE, struct_name);
+            ++var_it;
+            ++val_it;
+            continue;
         }
+        // El buffer de una concatenación que no escapa vive en el alcance de la variable
+        if (escapes.var_buffers.count(*val_it)) {
+            current_offset -= options.stack_buffer;
+            stack_buffers[*val_it] = current_offset;
+        }
+        ImpValue val_info(TSTRING);
+        bool stack_acc = stack_builder(*var_it, *val_it);
+        if (stack_acc) {
+            current_offset -= options.stack_buffer;
+            output << "  leaq " << frame_slot(current_offset) << ", %rax" << endl;
+            output << "  xorl %edx, %edx" << endl;
+        } else {
+            val_info = (*val_it)->accept(this);
+        }
+        int size = val_info.type == TSTRING ? 16 : 8;
+        bool builder = val_info.type == TSTRING && string_builders.count(*var_it);
+        current_offset -= builder ? 24 : size;
+        env.add_var(*var_it, current_offset, val_info.type, "", builder);
+        emit_store(current_offset, size);
+        if (builder) output << "  movq $" << (stack_acc ? options.stack_buffer : 0) << ", " << frame_slot(current_offset + 16) << endl;
         
         ++var_it;
         ++val_it;
@@ -342,20 +1894,44 @@ void GoCodeGen::visit(VarDecl* stmt) {
         var_size = env.get_struct(struct_name).size;
     } else if (auto basic = dynamic_cast<BasicType*>(stmt->type)) {
         var_type_enum = ImpValue::get_basic_type(basic->typeName);
+        if (var_type_enum == TSTRING) var_size = 16;
     }
 
     while (nameIt != stmt->names.end()) {
-        current_offset -= var_size;
-        env.add_var(*nameIt, current_offset, var_type_enum, struct_name);
+        Exp* value = hasInitializers && valueIt != stmt->values.end() ? *valueIt : nullptr;
+        if (escapes.var_buffers.count(value)) {
+            current_offset -= options.stack_buffer;
+            stack_buffers[value] = current_offset;
+        }
+        bool builder = var_type_enum == TSTRING && string_builders.count(*nameIt);
+        if (builder && stack_builder(*nameIt, value)) {
+            // El acumulador empieza vacío sobre un buffer del marco
+            current_offset -= options.stack_buffer;
+            int buffer = current_offset;
+            current_offset -= 24;
+            env.add_var(*nameIt, current_offset, var_type_enum, "", true);
+            output << "  leaq " << frame_slot(buffer) << ", %rax" << endl;
+            output << "  movq %rax, " << frame_slot(current_offset) << endl;
+            output << "  movq $0, " << frame_slot(current_offset + 8) << endl;
+            output << "  movq $" << options.stack_buffer << ", " << frame_slot(current_offset + 16) << endl;
+            if (value) ++valueIt;
+            ++nameIt;
+            continue;
+        }
+        current_offset -= frame_bytes(var_size) + (builder ? 8 : 0);
+        env.add_var(*nameIt, current_offset, var_type_enum, struct_name, builder);
         
         if (hasInitializers && valueIt != stmt->values.end()) {
-            (*valueIt)->accept(this);
-            output << "  movq %rax, " << current_offset << "(%rbp)" << endl;
+            if (!struct_name.empty()) {
+                store_struct_value(*valueIt, current_offset, struct_name);
+            } else {
+                (*valueIt)->accept(this);
+                emit_store(current_offset, var_type_enum == TSTRING ? 16 : 8);
+                if (builder) output << "  movq $0, " << frame_slot(current_offset + 16) << endl;
+            }
             ++valueIt;
         } else {
-            for (int i = 0; i < var_size; i += 8) {
-                output << "  movq $0, " << current_offset + i << "(%rbp)" << endl;
-            }
+            emit_zero(current_offset, var_size + (builder ? 8 : 0));
         }
         
         ++nameIt;
@@ -364,19 +1940,106 @@ void GoCodeGen::visit(VarDecl* stmt) {
 
 void GoCodeGen::visit(IncDecStmt* stmt) {
     VarInfo info = env.lookup(stmt->variable);
-    output << "  movq " << info.offset << "(%rbp), %rax" << endl;
+    output << "  movq " << frame_slot(info.offset) << ", %rax" << endl;
     if (stmt->isIncrement) output << "  incq %rax" << endl;
     else output << "  decq %rax" << endl;
-    output << "  movq %rax, " << info.offset << "(%rbp)" << endl;
+    output << "  movq %rax, " << frame_slot(info.offset) << endl;
+}
+
+string GoCodeGen::jump_for(BinaryOp op, bool jump_if) {
+    switch (op) {
+        case LT_OP: return jump_if ? "jl" : "jge";
+        case LE_OP: return jump_if ? "jle" : "jg";
+        case GT_OP: return jump_if ? "jg" : "jle";
+        case GE_OP: return jump_if ? "jge" : "jl";
+        case EQ_OP: return jump_if ? "je" : "jne";
+        case NE_OP: return jump_if ? "jne" : "je";
+        default: throw runtime_error("Operador sin salto condicional asociado.");
+    }
+}
+
+// Compila una condición en "contexto de salto": en lugar de materializar 0/1 con
+// setcc y volver a compararlo, el cmp alimenta directamente al jcc (quedan adyacentes
+// para que el CPU pueda fusionarlos). && y || se convierten en cadenas de saltos que
+// no evalúan el operando derecho cuando no hace falta, y ! solo invierte el destino.
+void GoCodeGen::generate_condition(Exp* cond, bool jump_if, const string& target) {
+    if (auto b = dynamic_cast<BoolExp*>(cond)) {
+        if (b->value == jump_if) output << "  jmp " << target << endl;
+        return;
+    }
+    if (auto u = dynamic_cast<UnaryExp*>(cond)) {
+        if (u->op == NOT_OP) {
+            generate_condition(u->exp, !jump_if, target);
+            return;
+        }
+    }
+    if (auto bin = dynamic_cast<BinaryExp*>(cond)) {
+        if (bin->op == AND_OP || bin->op == OR_OP) {
+            // a && b salta si ambos son verdaderos; a || b salta si alguno lo es.
+            // Si el operando izquierdo ya decide el resultado, se salta el derecho.
+            bool short_value = (bin->op == OR_OP);
+            if (jump_if == short_value) {
+                generate_condition(bin->left, jump_if, target);
+                generate_condition(bin->right, jump_if, target);
+            } else {
+                string skip_label = new_label();
+                generate_condition(bin->left, short_value, skip_label);
+                generate_condition(bin->right, jump_if, target);
+                output << skip_label << ":" << endl;
+            }
+            return;
+        }
+        if (bin->op == LT_OP || bin->op == LE_OP || bin->op == GT_OP ||
+            bin->op == GE_OP || bin->op == EQ_OP || bin->op == NE_OP) {
+            Exp* other;
+            string literal;
+            if (short_literal_operand(bin, other, literal)) {
+                // Salta a 'target' si la igualdad vale 'when_equal'
+                bool when_equal = (bin->op == EQ_OP) == jump_if;
+                string skip_label = new_label();
+                emit_literal_equality(other, literal, when_equal ? skip_label : target);
+                output << "  " << (when_equal ? "je " : "jne ") << target << endl;
+                if (when_equal) output << skip_label << ":" << endl;
+                return;
+            }
+            ImpValue v_left = bin->left->accept(this);
+            if (v_left.type == TSTRING) {
+                if (bin->op != EQ_OP && bin->op != NE_OP) {
+                    throw runtime_error("Operador binario no soportado para strings.");
+                }
+                this->needs_string_compare = true;
+                string_call_operands(bin->right);
+                emit_call("_equal_strings");
+                output << "  testl %eax, %eax" << endl;
+                // %eax es 1 si son iguales
+                output << "  " << jump_for(bin->op == EQ_OP ? NE_OP : EQ_OP, jump_if) << " " << target << endl;
+                return;
+            }
+            // Operandos derechos simples se comparan directamente, sin pasar por la pila
+            auto num = dynamic_cast<NumberExp*>(bin->right);
+            if (num && fits_imm32(num->value)) {
+                output << "  cmpq $" << num->value << ", %rax" << endl;
+            } else {
+                push_reg("%rax");
+                bin->right->accept(this);
+                output << "  movq %rax, %rcx" << endl;
+                pop_reg("%rax");
+                output << "  cmpq %rcx, %rax" << endl;
+            }
+            output << "  " << jump_for(bin->op, jump_if) << " " << target << endl;
+            return;
+        }
+    }
+    cond->accept(this);
+    output << "  testq %rax, %rax" << endl;
+    output << "  " << (jump_if ? "jne " : "je ") << target << endl;
 }
 
 void GoCodeGen::visit(IfStmt* stmt) {
     string else_label = new_label();
     string end_label = stmt->elseBlock ? new_label() : else_label;
     
-    stmt->condition->accept(this);
-    output << "  cmpq $0, %rax" << endl;
-    output << "  je " << else_label << endl;
+    generate_condition(stmt->condition, false, else_label);
     
     if (stmt->thenBlock) stmt->thenBlock->accept(this);
     if (stmt->elseBlock) output << "  jmp " << end_label << endl;
@@ -385,125 +2048,380 @@ void GoCodeGen::visit(IfStmt* stmt) {
     if (stmt->elseBlock) output << end_label << ":" << endl;
 }
 
+// El bucle se emite rotado: la condición se evalúa al final y salta de vuelta al
+// cuerpo, así cada iteración ejecuta un solo salto condicional en vez de jcc + jmp.
 void GoCodeGen::visit(ForStmt* stmt) {
-    string start_label = new_label(), end_label = new_label();
+    string body_label = new_label(), cond_label = new_label();
     env.add_level();
+    int scope_offset = current_offset;
     if (stmt->init) stmt->init->accept(this);
-    output << start_label << ":" << endl;
-    if (stmt->condition) {
-        stmt->condition->accept(this);
-        output << "  cmpq $0, %rax" << endl;
-        output << "  je " << end_label << endl;
-    }
+    if (stmt->condition) output << "  jmp " << cond_label << endl;
+    output << body_label << ":" << endl;
     if (stmt->body) stmt->body->accept(this);
     if (stmt->post) stmt->post->accept(this);
-    output << "  jmp " << start_label << endl;
-    output << end_label << ":" << endl;
+    if (stmt->condition) {
+        output << cond_label << ":" << endl;
+        generate_condition(stmt->condition, true, body_label);
+    } else {
+        output << "  jmp " << body_label << endl;
+    }
+    current_offset = scope_offset;
     env.remove_level();
 }
 
+// Llamada en posición de cola. Si es recursiva, los nuevos argumentos reemplazan a
+// los parámetros guardados y se vuelve al inicio del cuerpo; si no, se desarma el
+// marco propio y se salta a la función, que retorna directamente a nuestro llamador.
+// Solo aplica cuando todos los argumentos van en registros: los de pila vivirían
+// en el marco del llamador, que no es nuestro.
+// Los structs por valor pueden ocupar la pila del llamador o necesitar el destino
+// del resultado, así que solo se convierten llamadas entre funciones escalares
+static bool has_struct_signature(const FuncInfo& info) {
+    if (!info.return_struct.empty()) return true;
+    for (auto& name : info.param_structs) {
+        if (!name.empty()) return true;
+    }
+    return false;
+}
+
+bool GoCodeGen::generate_tail_call(FunctionCallExp* call) {
+    if (!options.tail_calls || current_function->name == "main") return false;
+    if (!env.has_function(call->funcName) || call->args.size() > NUM_ARG_REGS) return false;
+    FuncInfo callee = env.get_function(call->funcName);
+    if (has_struct_signature(callee) || has_struct_signature(env.get_function(current_function->name))) return false;
+    // Los strings ocupan dos registros: pueden no entrar todos
+    int stack_bytes;
+    layout_args(callee.param_types, callee.param_structs, false, stack_bytes);
+    if (stack_bytes != 0) return false;
+
+    if (call->funcName == current_function->name) {
+        generate_call_args(call->args, callee);
+        int i = 0;
+        // Los parámetros pueden estar ocultos por variables del cuerpo: se usan los offsets guardados
+        for (int offset : current_param_offsets) {
+            output << "  movq " << ARG_REGS[i++] << ", " << frame_slot(offset) << endl;
+        }
+        output << "  jmp " << current_entry_label << " # Recursión de cola" << endl;
+    } else {
+        generate_call_args(call->args, callee);
+        made_call = true;
+        output << "  leave" << endl;
+        output << "  jmp " << call->funcName << " # Llamada de cola" << endl;
+    }
+    return true;
+}
+
 void GoCodeGen::visit(ReturnStmt* stmt) {
-    if (stmt->expression) {
+    if (auto call = dynamic_cast<FunctionCallExp*>(stmt->expression)) {
+        if (generate_tail_call(call)) return;
+    }
+    string struct_name = env.get_function(current_function->name).return_struct;
+    if (stmt->expression && !struct_name.empty()) {
+        if (sret_slot) {
+            // El valor se escribe directamente en el destino que pasó el llamador
+            store_struct_value(stmt->expression, StructPlace(0, sret_slot), struct_name);
+            output << "  movq " << frame_slot(sret_slot) << ", %rax" << endl;
+        } else if (dynamic_cast<FunctionCallExp*>(stmt->expression)) {
+            if (struct_type_of(stmt->expression) != struct_name) {
+                throw runtime_error("Se esperaba un valor de tipo '" + struct_name + "'.");
+            }
+            stmt->expression->accept(this);
+        } else {
+            // Hasta 16 bytes vuelven en %rax:%rdx; un literal se arma antes en un temporal
+            int size = env.get_struct(struct_name).size;
+            int src;
+            string src_struct;
+            bool temp = !struct_location(stmt->expression, src, src_struct);
+            if (temp) {
+                current_offset -= frame_bytes(size);
+                src = current_offset;
+                store_new_struct(stmt->expression, src, struct_name);
+            } else if (src_struct != struct_name) {
+                throw runtime_error("Se esperaba un valor de tipo '" + struct_name + "'.");
+            }
+            output << "  movq " << frame_slot(src) << ", %rax" << endl;
+            if (size > 8) output << "  movq " << frame_slot(src + 8) << ", %rdx" << endl;
+            if (temp) current_offset += frame_bytes(size);
+        }
+    } else if (stmt->expression) {
         stmt->expression->accept(this);
     }
     output << "  jmp " << current_epilogue_label << endl;
 }
 
-void GoCodeGen::visit(TypeDecl* decl) {}
-void GoCodeGen::visit(ImportDecl* decl) {}
+void GoCodeGen::visit(BlockStmt* stmt) {
+    if (stmt->block) stmt->block->accept(this);
+}
+
+void GoCodeGen::visit(TypeDecl*) {}
+void GoCodeGen::visit(ImportDecl*) {}
+
+// s == "lit" o "lit" != s con un literal de hasta 16 bytes: se compara en línea
+bool GoCodeGen::short_literal_operand(BinaryExp* exp, Exp*& other, string& literal) {
+    if (exp->op != EQ_OP && exp->op != NE_OP) return false;
+    auto right = dynamic_cast<StringExp*>(exp->right);
+    auto left = dynamic_cast<StringExp*>(exp->left);
+    if (right && right->value.size() <= 16) {
+        other = exp->left;
+        literal = right->value;
+        return true;
+    }
+    if (left && left->value.size() <= 16) {
+        other = exp->right;
+        literal = left->value;
+        return true;
+    }
+    return false;
+}
+
+// Evalúa 'other' y lo compara con el literal: primero el largo y después los bytes,
+// con lecturas de 8, 4, 2 o 1 bytes contra inmediatos (dos lecturas que se solapan
+// cubren los largos intermedios). Cada diferencia salta a 'mismatch' con ZF = 0; la
+// última comparación queda en las banderas (ZF = 1 si son iguales).
+void GoCodeGen::emit_literal_equality(Exp* other, const string& literal, const string& mismatch) {
+    other->accept(this);
+    int n = literal.size();
+    vector<pair<int, int>> chunks; // (offset, ancho)
+    int width = n >= 8 ? 8 : n >= 4 ? 4 : n >= 2 ? 2 : 1;
+    if (n > 0) chunks.push_back({0, width});
+    if (n > width) chunks.push_back({n - width, width});
+
+    output << "  cmpq $" << n << ", %rdx" << endl;
+    for (auto& chunk : chunks) {
+        output << "  jne " << mismatch << endl;
+        unsigned long long value = 0;
+        for (int b = chunk.second - 1; b >= 0; b--) {
+            value = (value << 8) | (unsigned char)literal[chunk.first + b];
+        }
+        string mem = to_string(chunk.first) + "(%rax)";
+        switch (chunk.second) {
+            case 8:
+                output << "  movabsq $" << value << ", %rcx" << endl;
+                output << "  cmpq %rcx, " << mem << endl;
+                break;
+            case 4: output << "  cmpl $" << value << ", " << mem << endl; break;
+            case 2: output << "  cmpw $" << value << ", " << mem << endl; break;
+            default: output << "  cmpb $" << value << ", " << mem << endl; break;
+        }
+    }
+}
+
+void GoCodeGen::string_call_operands(Exp* right) {
+    push_reg("%rdx");
+    push_reg("%rax", true);
+    right->accept(this);
+    output << "  movq %rdx, %rcx" << endl;
+    output << "  movq %rax, %rdx" << endl;
+    pop_reg("%rdi");
+    pop_reg("%rsi");
+}
 
 ImpValue GoCodeGen::visit(BinaryExp* exp) {
-    ImpValue v_left = exp->left->accept(this);
-    output << "  pushq %rax" << endl;
-    ImpValue v_right = exp->right->accept(this);
-    output << "  movq %rax, %rbx" << endl;
-    output << "  popq %rax" << endl;
+    if (exp->op == AND_OP || exp->op == OR_OP) {
+        // En contexto de valor también hay cortocircuito: el operando derecho
+        // solo se evalúa si el izquierdo no decide el resultado.
+        string false_label = new_label(), end_label = new_label();
+        generate_condition(exp, false, false_label);
+        output << "  movq $1, %rax" << endl;
+        output << "  jmp " << end_label << endl;
+        output << false_label << ":" << endl;
+        output << "  movq $0, %rax" << endl;
+        output << end_label << ":" << endl;
+        return ImpValue(TBOOL);
+    }
 
-    if (v_left.type == TSTRING && v_right.type == TSTRING) {
-        output << "  movq %rax, %rdi" << endl;
-        output << "  movq %rbx, %rsi" << endl;
+    Exp* other;
+    string literal;
+    if (short_literal_operand(exp, other, literal)) {
+        // Los saltos por diferencia llegan con ZF = 0, igual que la última comparación
+        string done_label = new_label();
+        emit_literal_equality(other, literal, done_label);
+        output << done_label << ":" << endl;
+        output << "  " << (exp->op == EQ_OP ? "sete" : "setne") << " %al" << endl;
+        output << "  movzbq %al, %rax" << endl;
+        return ImpValue(TBOOL);
+    }
+
+    if (exp->op == PLUS_OP && is_string_exp(exp)) {
+        vector<Exp*> pieces;
+        flatten_concat(exp, pieces);
+        generate_concat(pieces, stack_buffer_of(exp));
+        return ImpValue(TSTRING);
+    }
 
+    ImpValue v_left = exp->left->accept(this);
+    if (v_left.type == TSTRING) {
+        string_call_operands(exp->right);
         switch(exp->op) {
             case PLUS_OP:
                 this->needs_string_concat = true; 
-                output << "  call _concat_strings" << endl;
+                emit_call("_concat_strings");
                 return ImpValue(TSTRING);
             case EQ_OP:
                 this->needs_string_compare = true; 
-                output << "  call _compare_strings" << endl;
-                output << "  cmpq $0, %rax" << endl;
-                output << "  sete %al" << endl;
-                output << "  movzbq %al, %rax" << endl;
+                emit_call("_equal_strings");
                 return ImpValue(TBOOL);
             case NE_OP:
                 this->needs_string_compare = true; 
-                output << "  call _compare_strings" << endl;
-                output << "  cmpq $0, %rax" << endl;
-                output << "  setne %al" << endl;
-                output << "  movzbq %al, %rax" << endl;
+                emit_call("_equal_strings");
+                output << "  xorq $1, %rax" << endl;
                 return ImpValue(TBOOL);
             default:
                 throw runtime_error("Operador binario no soportado para strings.");
         }
     }
+    // Una constante a la derecha se usa como inmediato y una variable se carga
+    // directo en %rcx, sin pasar por la pila (idivq no acepta inmediatos)
+    string operand = "%rcx";
+    auto num = dynamic_cast<NumberExp*>(exp->right);
+    if (num && fits_imm32(num->value) && exp->op != DIV_OP && exp->op != MOD_OP) {
+        operand = "$" + to_string(num->value);
+    } else if (is_direct_operand(exp->right)) {
+        load_direct(exp->right, "%rcx", "");
+    } else {
+        push_reg("%rax");
+        exp->right->accept(this);
+        output << "  movq %rax, %rcx" << endl;
+        pop_reg("%rax");
+    }
 
     string set_instruction;
     switch (exp->op) {
-        case PLUS_OP: output << "  addq %rbx, %rax" << endl; return ImpValue(TINT);
-        case MINUS_OP: output << "  subq %rbx, %rax" << endl; return ImpValue(TINT);
-        case MUL_OP: output << "  imulq %rbx, %rax" << endl; return ImpValue(TINT);
-        case DIV_OP: output << "  cqto" << endl; output << "  idivq %rbx" << endl; return ImpValue(TINT);
-        case MOD_OP: output << "  cqto" << endl; output << "  idivq %rbx" << endl; output << "  movq %rdx, %rax" << endl; return ImpValue(TINT);
+        case PLUS_OP: output << "  addq " << operand << ", %rax" << endl; return ImpValue(TINT);
+        case MINUS_OP: output << "  subq " << operand << ", %rax" << endl; return ImpValue(TINT);
+        case MUL_OP: output << "  imulq " << operand << ", %rax" << endl; return ImpValue(TINT);
+        case DIV_OP: emit_division(exp->right, false); return ImpValue(TINT);
+        case MOD_OP: emit_division(exp->right, true); return ImpValue(TINT);
         case LT_OP: set_instruction = "setl"; goto compare;
         case LE_OP: set_instruction = "setle"; goto compare;
         case GT_OP: set_instruction = "setg"; goto compare;
         case GE_OP: set_instruction = "setge"; goto compare;
         case EQ_OP: set_instruction = "sete"; goto compare;
         case NE_OP: set_instruction = "setne"; goto compare;
-        case AND_OP: {
-            string f_l = new_label(), e_l = new_label();
-            output << "  cmpq $0, %rax" << endl; output << "  je " << f_l << endl;
-            output << "  cmpq $0, %rbx" << endl; output << "  je " << f_l << endl;
-            output << "  movq $1, %rax" << endl; output << "  jmp " << e_l << endl;
-            output << f_l << ":" << endl; output << "  movq $0, %rax" << endl;
-            output << e_l << ":" << endl; break;
-        }
-        case OR_OP: {
-            string true_label = new_label(), end_label = new_label();
-            output << "  cmpq $0, %rax" << endl; output << "  jne " << true_label << endl;
-            output << "  cmpq $0, %rbx" << endl; output << "  jne " << true_label << endl;
-            output << "  movq $0, %rax" << endl; output << "  jmp " << end_label << endl;
-            output << true_label << ":" << endl; output << "  movq $1, %rax" << endl;
-            output << end_label << ":" << endl; break;
-        }
+        case AND_OP:
+        case OR_OP:
+            break;
     }
     return ImpValue(TBOOL);
 compare:
-    output << "  cmpq %rbx, %rax" << endl;
+    output << "  cmpq " << operand << ", %rax" << endl;
     output << "  " << set_instruction << " %al" << endl;
     output << "  movzbq %al, %rax" << endl;
     return ImpValue(TBOOL);
 }
 
 ImpValue GoCodeGen::visit(UnaryExp* exp) {
-    exp->exp->accept(this);
+    ImpValue val = exp->exp->accept(this);
     switch (exp->op) {
-        case UMINUS_OP: output << "  negq %rax" << endl; break;
-        case NOT_OP: output << "  cmpq $0, %rax" << endl; output << "  sete %al" << endl; output << "  movzbq %al, %rax" << endl; break;
+        case UMINUS_OP: output << "  negq %rax" << endl; return ImpValue(TINT);
+        case NOT_OP: output << "  xorq $1, %rax" << endl; return ImpValue(TBOOL);
         case UPLUS_OP: break;
     }
-    return ImpValue();
+    return val;
 }
 
 ImpValue GoCodeGen::visit(NumberExp* exp) { 
-    output << "  movq $" << exp->value << ", %rax" << endl;
-    return ImpValue(exp->value);
+    load_direct(exp, "%rax", "");
+    return ImpValue(TINT);
 }
+// Un string es el par (puntero, largo): el puntero en %rax y el largo en %rdx. El
+// largo de un literal es una constante, así que len y la concatenación no recorren bytes
 ImpValue GoCodeGen::visit(StringExp* exp) { 
-    string label = string_literals[exp->value]; 
-    output << "  leaq " << label << "(%rip), %rax" << endl; 
+    emit_string_literal(exp->value);
     return ImpValue(exp->value); 
 }
+
+void GoCodeGen::emit_string_literal(const string& value) {
+    output << "  leaq " << string_label(value) << "(%rip), %rax" << endl; 
+    output << "  movq $" << value.size() << ", %rdx" << endl;
+}
+
+// true si la expresión es un string, sin generar código
+bool GoCodeGen::is_string_exp(Exp* e) {
+    if (dynamic_cast<StringExp*>(e) || dynamic_cast<SliceExp*>(e)) return true;
+    if (auto bin = dynamic_cast<BinaryExp*>(e)) return bin->op == PLUS_OP && is_string_exp(bin->left);
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) return env.lookup(id->name).type == TSTRING;
+    if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        int offset;
+        FieldInfo finfo;
+        field_location(fa, offset, finfo);
+        return finfo.type == TSTRING;
+    }
+    if (auto call = dynamic_cast<FunctionCallExp*>(e)) {
+        return env.has_function(call->funcName) && env.get_function(call->funcName).return_type == TSTRING;
+    }
+    return false;
+}
+
+// Concatena las piezas con una sola reserva. Los literales consecutivos se juntan en
+// compilación, así que una cadena de solo literales es un literal más. Con dos piezas
+// se usa _concat_strings; con más, cada pieza se escribe como (puntero, largo) en un
+// arreglo en la pila y _concat_strings_n suma los largos, reserva una vez y copia
+// cada pieza una sola vez. Si el resultado no escapa, las variantes _into lo escriben
+// en el buffer del marco cuando entra.
+void GoCodeGen::generate_concat(const vector<Exp*>& pieces, int buffer) {
+    vector<Exp*> merged;
+    vector<string> literals;
+    for (auto piece : pieces) {
+        auto str = dynamic_cast<StringExp*>(piece);
+        if (str && !merged.empty() && !merged.back()) {
+            literals.back() += str->value;
+            continue;
+        }
+        merged.push_back(str ? nullptr : piece);
+        literals.push_back(str ? str->value : "");
+    }
+    auto emit_piece = [&](size_t i) {
+        if (merged[i]) merged[i]->accept(this);
+        else emit_string_literal(literals[i]);
+    };
+
+    if (merged.size() == 1) {
+        emit_piece(0);
+    } else if (merged.size() == 2) {
+        this->needs_string_concat = true;
+        emit_piece(0);
+        push_reg("%rdx");
+        push_reg("%rax", true);
+        emit_piece(1);
+        output << "  movq %rdx, %rcx" << endl;
+        output << "  movq %rax, %rdx" << endl;
+        pop_reg("%rdi");
+        pop_reg("%rsi");
+        if (buffer) {
+            output << "  leaq " << frame_slot(buffer) << ", %r8" << endl;
+            output << "  movl $" << options.stack_buffer << ", %r9d" << endl;
+            emit_call("_concat_strings_into");
+        } else {
+            emit_call("_concat_strings");
+        }
+    } else {
+        this->needs_string_concat_n = true;
+        int bytes = 16 * merged.size();
+        output << "  subq $" << bytes << ", %rsp" << endl;
+        stack_depth += bytes;
+        vector<int> words;
+        for (size_t i = 0; i < merged.size(); i++) words.push_back(16 * i);
+        note_pointer_area(words);
+        int area = stack_top_offset();
+        for (size_t i = 0; i < merged.size(); i++) {
+            emit_piece(i);
+            emit_store(area + 16 * i, 16);
+        }
+        output << "  leaq " << frame_slot(area) << ", %rdi" << endl;
+        output << "  movq $" << merged.size() << ", %rsi" << endl;
+        if (buffer) {
+            output << "  leaq " << frame_slot(buffer) << ", %rdx" << endl;
+            output << "  movl $" << options.stack_buffer << ", %ecx" << endl;
+            emit_call("_concat_strings_n_into");
+        } else {
+            emit_call("_concat_strings_n");
+        }
+        output << "  addq $" << bytes << ", %rsp" << endl;
+        stack_depth -= bytes;
+        release_pointer_temps();
+    }
+}
 ImpValue GoCodeGen::visit(BoolExp* exp) {
     output << "  movq $" << (exp->value ? 1 : 0) << ", %rax" << endl;
     return ImpValue(exp->value);
@@ -512,85 +2430,547 @@ ImpValue GoCodeGen::visit(BoolExp* exp) {
 ImpValue GoCodeGen::visit(IdentifierExp* exp) {
     VarInfo info = env.lookup(exp->name);
     if (info.struct_name.empty()) {
-        output << "  movq " << info.offset << "(%rbp), %rax" << endl;
+        emit_load(info.offset, info.type == TSTRING ? 16 : 8, "%rax");
     }
     ImpValue val(info.type);
     val.struct_name = info.struct_name;
     return val; 
 }
 
+// Todos los campos son enteros o punteros, así que System V clasifica cada mitad de
+// 8 bytes de un struct chico como INTEGER; los de más de 16 bytes van por memoria
+int GoCodeGen::struct_regs(const string& struct_name) {
+    int size = env.get_struct(struct_name).size;
+    return size > 16 ? 0 : max(1, (size + 7) / 8);
+}
+
+// Asigna registros a los argumentos en orden (%rdi queda para el destino de un
+// struct devuelto por memoria). Un struct que no entra completo en los registros
+// restantes va a la pila, y los argumentos siguientes pueden seguir usándolos.
+vector<ArgSlot> GoCodeGen::layout_args(const vector<ImpVType>& arg_types, const vector<string>& arg_structs,
+                                       bool sret, int& stack_bytes) {
+    vector<ArgSlot> slots;
+    int next_reg = sret ? 1 : 0;
+    stack_bytes = 0;
+    for (size_t i = 0; i < arg_structs.size(); i++) {
+        const string& name = arg_structs[i];
+        ArgSlot slot{-1, 1, 0, name, i < arg_types.size() && arg_types[i] == TSTRING};
+        int size = 8;
+        if (!name.empty()) {
+            slot.regs = struct_regs(name);
+            size = frame_bytes(env.get_struct(name).size);
+        } else if (slot.is_string) {
+            slot.regs = 2;
+            size = 16;
+        }
+        if (slot.regs > 0 && next_reg + slot.regs <= NUM_ARG_REGS) {
+            slot.reg = next_reg;
+            next_reg += slot.regs;
+        } else {
+            slot.stack_offset = stack_bytes;
+            stack_bytes += size;
+        }
+        slots.push_back(slot);
+    }
+    return slots;
+}
+
+// Deja los argumentos de una llamada en %rdi..%r9 y en la pila, y en %rdi la
+// dirección 'sret' si la función devuelve un struct por memoria. Devuelve los
+// bytes que hay que liberar de la pila después del call.
+int GoCodeGen::generate_call_args(const list<Exp*>& arg_list, const FuncInfo& callee, const StructPlace* sret) {
+    vector<Exp*> args(arg_list.begin(), arg_list.end());
+    vector<string> arg_structs(args.size());
+    for (size_t i = 0; i < args.size() && i < callee.param_structs.size(); i++) arg_structs[i] = callee.param_structs[i];
+    int stack_bytes;
+    vector<ArgSlot> slots = layout_args(callee.param_types, arg_structs, sret != nullptr, stack_bytes);
+
+    // Argumentos que no van en registros: en el área de la pila, que se reserva de
+    // una vez con el relleno necesario para que %rsp quede alineado en el call.
+    // Los structs se escriben ahí directamente (es la copia que recibe el llamado).
+    int reserved = stack_bytes + (stack_depth + stack_bytes) % 16;
+    if (reserved) {
+        output << "  subq $" << reserved << ", %rsp" << endl;
+        stack_depth += reserved;
+    }
+    int area = stack_top_offset();
+    vector<int> area_words;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (slots[i].reg >= 0) continue;
+        if (!slots[i].struct_name.empty()) string_words(slots[i].struct_name, slots[i].stack_offset, area_words);
+        else if (slots[i].is_string) area_words.push_back(slots[i].stack_offset);
+    }
+    note_pointer_area(area_words);
+    for (size_t i = 0; i < args.size(); i++) {
+        if (slots[i].reg >= 0) continue;
+        if (!slots[i].struct_name.empty()) {
+            store_struct_value(args[i], area + slots[i].stack_offset, slots[i].struct_name);
+        } else {
+            args[i]->accept(this);
+            emit_store(area + slots[i].stack_offset, slots[i].is_string ? 16 : 8);
+        }
+    }
+
+    // Argumentos en registros. Los que requieren cálculo pasan por %rax (y
+    // pueden llamar funciones que pisan los registros de argumentos), así que
+    // se evalúan primero; el último va directo a su registro y los anteriores
+    // esperan en la pila. Las variables y constantes se cargan al final
+    // directamente en su registro. Un struct espera en la pila como sus 8 o 16
+    // bytes, así cada pop saca su siguiente mitad; un string, como su puntero y su largo.
+    auto is_direct = [&](int i) {
+        if (slots[i].struct_name.empty()) return is_direct_operand(args[i]);
+        return !dynamic_cast<StructLiteralExp*>(args[i]) && !dynamic_cast<FunctionCallExp*>(args[i]);
+    };
+    vector<int> computed;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (slots[i].reg >= 0 && !is_direct(i)) computed.push_back(i);
+    }
+    for (size_t k = 0; k < computed.size(); k++) {
+        const ArgSlot& slot = slots[computed[k]];
+        Exp* arg = args[computed[k]];
+        bool last = k + 1 == computed.size();
+        if (slot.struct_name.empty() && !slot.is_string) {
+            arg->accept(this);
+            if (!last) push_reg("%rax");
+            else output << "  movq %rax, " << ARG_REGS[slot.reg] << endl;
+        } else if (slot.is_string || dynamic_cast<FunctionCallExp*>(arg)) {
+            if (slot.is_string) {
+                arg->accept(this);
+            } else {
+                auto call = static_cast<FunctionCallExp*>(arg);
+                if (struct_type_of(call) != slot.struct_name) {
+                    throw runtime_error("Se esperaba un valor de tipo '" + slot.struct_name + "'.");
+                }
+                generate_user_call(call, nullptr);
+            }
+            if (!last) {
+                vector<int> words;
+                if (slot.is_string) words.push_back(0);
+                else string_words(slot.struct_name, 0, words);
+                bool pointers[2] = {count(words.begin(), words.end(), 0) > 0, count(words.begin(), words.end(), 8) > 0};
+                if (slot.regs == 2) push_reg("%rdx", pointers[1]);
+                push_reg("%rax", pointers[0]);
+            } else {
+                if (slot.regs == 2) output << "  movq %rdx, " << ARG_REGS[slot.reg + 1] << endl;
+                output << "  movq %rax, " << ARG_REGS[slot.reg] << endl;
+            }
+        } else {
+            output << "  subq $" << slot.regs * 8 << ", %rsp" << endl;
+            stack_depth += slot.regs * 8;
+            vector<int> words;
+            string_words(slot.struct_name, 0, words);
+            note_pointer_area(words);
+            store_struct_value(arg, stack_top_offset(), slot.struct_name);
+            if (last) {
+                for (int r = 0; r < slot.regs; r++) pop_reg(ARG_REGS[slot.reg + r]);
+            }
+        }
+    }
+    for (int k = (int)computed.size() - 2; k >= 0; k--) {
+        const ArgSlot& slot = slots[computed[k]];
+        for (int r = 0; r < slot.regs; r++) pop_reg(ARG_REGS[slot.reg + r]);
+    }
+    for (size_t i = 0; i < args.size(); i++) {
+        if (slots[i].reg < 0 || !is_direct(i)) continue;
+        if (slots[i].struct_name.empty()) {
+            load_direct(args[i], ARG_REGS[slots[i].reg], slots[i].is_string ? ARG_REGS[slots[i].reg + 1] : "");
+            continue;
+        }
+        int src;
+        string src_struct;
+        struct_location(args[i], src, src_struct);
+        if (src_struct != slots[i].struct_name) {
+            throw runtime_error("Se esperaba un valor de tipo '" + slots[i].struct_name + "'.");
+        }
+        for (int r = 0; r < slots[i].regs; r++) {
+            output << "  movq " << frame_slot(src + 8 * r) << ", " << ARG_REGS[slots[i].reg + r] << endl;
+        }
+    }
+    if (sret) load_place_address(*sret, "%rdi");
+
+    return reserved;
+}
+
+ImpValue GoCodeGen::generate_user_call(FunctionCallExp* exp, const StructPlace* sret) {
+    if (!env.has_function(exp->funcName)) {
+        throw runtime_error("Llamada a función no definida '" + exp->funcName + "'");
+    }
+    FuncInfo info = env.get_function(exp->funcName);
+
+    // Un struct devuelto por memoria que nadie recibe se escribe en un temporal de la pila
+    int temp = 0;
+    StructPlace temp_place(0);
+    if (!info.return_struct.empty() && struct_regs(info.return_struct) == 0 && !sret) {
+        temp = (env.get_struct(info.return_struct).size + 15) & -16;
+        output << "  subq $" << temp << ", %rsp" << endl;
+        stack_depth += temp;
+        vector<int> words;
+        string_words(info.return_struct, 0, words);
+        note_pointer_area(words);
+        temp_place = StructPlace(stack_top_offset());
+        sret = &temp_place;
+    }
+
+    int cleanup = generate_call_args(exp->args, info, sret) + temp;
+    made_call = true;
+    output << "  call " << exp->funcName << endl;
+    record_gc_site();
+
+    if (cleanup > 0) {
+        output << "  addq $" << cleanup << ", %rsp" << endl;
+        stack_depth -= cleanup;
+        release_pointer_temps();
+    }
+
+    ImpValue val(info.return_type);
+    val.struct_name = info.return_struct;
+    return val;
+}
+
 ImpValue GoCodeGen::visit(FunctionCallExp* exp) {
     if (exp->funcName == "len") {
         if (exp->args.size() != 1) throw runtime_error("'len' espera 1 argumento.");
-        ImpValue arg_val = exp->args.front()->accept(this);
+        // El largo viaja con el string: no hace falta recorrerlo
+        Exp* arg = exp->args.front();
+        if (auto str = dynamic_cast<StringExp*>(arg)) {
+            output << "  movq $" << str->value.size() << ", %rax" << endl;
+            return ImpValue(TINT);
+        }
+        if (auto id = dynamic_cast<IdentifierExp*>(arg)) {
+            VarInfo info = env.lookup(id->name);
+            if (info.type == TSTRING) {
+                output << "  movq " << frame_slot(info.offset + 8) << ", %rax" << endl;
+                return ImpValue(TINT);
+            }
+        }
+        ImpValue arg_val = arg->accept(this);
         if (arg_val.type != TSTRING) throw runtime_error("'len' solo soporta strings.");
-        output << "  movq %rax, %rdi" << endl;
-        output << "  call strlen@PLT" << endl;
+        output << "  movq %rdx, %rax" << endl;
         return ImpValue(TINT);
     }
     if (exp->funcName == "fmt.Println") {
-        for (auto arg : exp->args) {
-            ImpValue val = arg->accept(this);
+        generate_println(exp->args);
+        return ImpValue();
+    } else {
+        return generate_user_call(exp, nullptr);
+    }
+}
+
+// Texto que fmt.Println imprimiría para un argumento conocido en compilación: enteros
+// (con signo), booleanos, literales y concatenaciones de solo literales
+static bool constant_text(Exp* e, string& text) {
+    if (auto num = dynamic_cast<NumberExp*>(e)) {
+        text = to_string(num->value);
+        return true;
+    }
+    if (auto b = dynamic_cast<BoolExp*>(e)) {
+        text = b->value ? "true" : "false";
+        return true;
+    }
+    if (auto str = dynamic_cast<StringExp*>(e)) {
+        text = str->value;
+        return true;
+    }
+    if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        auto num = dynamic_cast<NumberExp*>(u->exp);
+        if (!num || u->op == NOT_OP) return false;
+        long long value = u->op == UMINUS_OP ? (long long)(0ULL - (unsigned long long)num->value) : num->value;
+        text = to_string(value);
+        return true;
+    }
+    auto bin = dynamic_cast<BinaryExp*>(e);
+    if (!bin || bin->op != PLUS_OP) return false;
+    vector<Exp*> pieces;
+    flatten_concat(bin, pieces);
+    text.clear();
+    for (auto piece : pieces) {
+        auto str = dynamic_cast<StringExp*>(piece);
+        if (!str) return false;
+        text += str->value;
+    }
+    return true;
+}
+
+// Como en Go, los argumentos se separan con un espacio y la línea termina con un
+// salto. Cada argumento es una sola llamada que escribe el valor y su separador: al
+// buffer de salida (_out_int, _out_str, _out_bool) o, con -fno-buffered-output, con
+// printf. Con el buffer, cada tramo de argumentos constantes consecutivos se
+// imprime ya renderizado (con sus espacios) desde un literal de .rodata en una sola
+// llamada a _out_str, sin formatear nada en ejecución
+void GoCodeGen::generate_println(const list<Exp*>& args) {
+    if (args.empty()) {
+        if (needs_output_buffer) {
+            output << "  xorl %esi, %esi" << endl;
+            output << "  movl $10, %edx" << endl;
+            emit_call("_out_str");
+        } else {
+            output << "  leaq print_str_fmt(%rip), %rdi" << endl;
+            output << "  xorl %esi, %esi" << endl;
+            output << "  movq %rdi, %rdx" << endl;
+            output << "  movl $10, %ecx" << endl;
+            output << "  movl $0, %eax" << endl;
+            emit_call("printf@PLT");
+        }
+        return;
+    }
+    vector<Exp*> items(args.begin(), args.end());
+    for (size_t i = 0; i < items.size(); i++) {
+        string text, piece;
+        size_t end = i;
+        while (needs_output_buffer && end < items.size() && constant_text(items[end], piece)) {
+            if (end > i) text += ' ';
+            text += piece;
+            end++;
+        }
+        if (end > i) {
+            int separator = end == items.size() ? '\n' : ' ';
+            i = end - 1;
+            output << "  leaq " << string_label(text) << "(%rip), %rdi" << endl;
+            output << "  movq $" << text.size() << ", %rsi" << endl;
+            output << "  movl $" << separator << ", %edx" << endl;
+            emit_call("_out_str");
+            continue;
+        }
+        int separator = i + 1 == items.size() ? '\n' : ' ';
+        Exp* arg = items[i];
+        ImpValue val = arg->accept(this);
+        if (needs_output_buffer) {
+            output << "  movq %rax, %rdi" << endl;
             if (val.type == TSTRING) {
-                output << "  movq %rax, %rsi" << endl;
-                output << "  leaq print_str_fmt(%rip), %rdi" << endl;
-            } else if(val.type == TBOOL){
-                string false_label = new_label();
-                string end_label = new_label();
-                output << "  cmpq $0, %rax" << endl;
-                output << "  je " << false_label << endl;
-                output << "  leaq print_bool_true(%rip), %rdi" << endl;
-                output << "  jmp " << end_label << endl;
-                output << false_label << ":" << endl;
-                output << "  leaq print_bool_false(%rip), %rdi" << endl;
-                output << end_label << ":" << endl;
-                // Para este caso, %rsi no se usa, ya que la cadena de formato no tiene %s
-            } 
-            else { // TINT
-                output << "  movq %rax, %rsi" << endl;
-                output << "  leaq print_fmt(%rip), %rdi" << endl;
+                output << "  movq %rdx, %rsi" << endl;
+                output << "  movl $" << separator << ", %edx" << endl;
+                emit_call("_out_str");
+            } else {
+                output << "  movl $" << separator << ", %esi" << endl;
+                emit_call(val.type == TBOOL ? "_out_bool" : "_out_int");
             }
-            output << "  movl $0, %eax" << endl; // Para funciones variádicas, setear %eax a 0
-            output << "  call printf@PLT" << endl;
+            continue;
         }
-        return ImpValue();
+        if (val.type == TSTRING) {
+            output << "  movq %rdx, %rsi" << endl;
+            output << "  movq %rax, %rdx" << endl;
+            output << "  movl $" << separator << ", %ecx" << endl;
+            output << "  leaq print_str_fmt(%rip), %rdi" << endl;
+        } else if (val.type == TBOOL) {
+            output << "  leaq print_bool_true(%rip), %rsi" << endl;
+            output << "  leaq print_bool_false(%rip), %rcx" << endl;
+            output << "  testq %rax, %rax" << endl;
+            output << "  cmoveq %rcx, %rsi" << endl;
+            output << "  movl $" << separator << ", %edx" << endl;
+            output << "  leaq print_bool_fmt(%rip), %rdi" << endl;
+        } else { // TINT
+            output << "  movq %rax, %rsi" << endl;
+            output << "  movl $" << separator << ", %edx" << endl;
+            output << "  leaq print_fmt(%rip), %rdi" << endl;
+        }
+        output << "  movl $0, %eax" << endl; // Para funciones variádicas, setear %eax a 0
+        emit_call("printf@PLT");
+    }
+}
+
+bool GoCodeGen::is_direct_operand(Exp* e) {
+    if (dynamic_cast<NumberExp*>(e) || dynamic_cast<BoolExp*>(e) || dynamic_cast<StringExp*>(e)) {
+        return true;
+    }
+    if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        return env.lookup(id->name).struct_name.empty();
+    }
+    if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        int offset;
+        FieldInfo finfo;
+        field_location(fa, offset, finfo);
+        return finfo.struct_name.empty();
+    }
+    return false;
+}
+
+void GoCodeGen::load_direct(Exp* e, const string& reg, const string& reg2) {
+    if (auto num = dynamic_cast<NumberExp*>(e)) {
+        output << (fits_imm32(num->value) ? "  movq $" : "  movabsq $") << num->value << ", " << reg << endl;
+    } else if (auto b = dynamic_cast<BoolExp*>(e)) {
+        output << "  movq $" << (b->value ? 1 : 0) << ", " << reg << endl;
+    } else if (auto str = dynamic_cast<StringExp*>(e)) {
+        output << "  leaq " << string_label(str->value) << "(%rip), " << reg << endl;
+        if (!reg2.empty()) output << "  movq $" << str->value.size() << ", " << reg2 << endl;
+    } else if (auto id = dynamic_cast<IdentifierExp*>(e)) {
+        VarInfo info = env.lookup(id->name);
+        emit_load(info.offset, info.type == TSTRING && !reg2.empty() ? 16 : 8, reg, reg2);
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(e)) {
+        int offset;
+        FieldInfo finfo;
+        field_location(fa, offset, finfo);
+        emit_load(offset, finfo.size == 16 && reg2.empty() ? 8 : finfo.size, reg, reg2);
+    }
+}
+
+// Offset en el marco e información de un acceso a campo, incluyendo cadenas de
+// structs anidados (a.b.c)
+void GoCodeGen::field_location(FieldAccessExp* exp, int& offset, FieldInfo& finfo) {
+    string struct_name;
+    if (auto obj_id = dynamic_cast<IdentifierExp*>(exp->object)) {
+        VarInfo var_info = env.lookup(obj_id->name);
+        offset = var_info.offset;
+        struct_name = var_info.struct_name;
+    } else if (auto inner = dynamic_cast<FieldAccessExp*>(exp->object)) {
+        FieldInfo inner_info;
+        field_location(inner, offset, inner_info);
+        struct_name = inner_info.struct_name;
+    } else {
+        throw runtime_error("Acceso a campos solo en variables.");
+    }
+    if (struct_name.empty()) throw runtime_error("Variable no es un struct.");
+
+    StructInfo sinfo = env.get_struct(struct_name);
+    if (sinfo.fields.find(exp->field) == sinfo.fields.end()) {
+        throw runtime_error("Struct no tiene campo '" + exp->field + "'.");
+    }
+    finfo = sinfo.fields.at(exp->field);
+    offset += finfo.offset;
+}
+
+bool GoCodeGen::struct_location(Exp* exp, int& offset, string& struct_name) {
+    if (auto id = dynamic_cast<IdentifierExp*>(exp)) {
+        VarInfo info = env.lookup(id->name);
+        offset = info.offset;
+        struct_name = info.struct_name;
+    } else if (auto fa = dynamic_cast<FieldAccessExp*>(exp)) {
+        FieldInfo finfo;
+        field_location(fa, offset, finfo);
+        struct_name = finfo.struct_name;
     } else {
-        if (!env.has_function(exp->funcName)) {
-            throw runtime_error("Llamada a función no definida '" + exp->funcName + "'");
+        return false;
+    }
+    return !struct_name.empty();
+}
+
+ImpValue GoCodeGen::visit(FieldAccessExp* exp) {
+    int offset;
+    FieldInfo finfo;
+    field_location(exp, offset, finfo);
+    if (!finfo.struct_name.empty()) {
+        // Un struct anidado no cabe en %rax: se usa por su ubicación
+        ImpValue val;
+        val.type = NOTYPE;
+        val.struct_name = finfo.struct_name;
+        return val;
+    }
+    emit_load(offset, finfo.size, "%rax");
+    return ImpValue(finfo.type);
+}
+
+// Un literal posicional da un valor a cada campo, en el orden de declaración (no el
+// de su ubicación); uno con claves puede omitir campos, pero no repetirlos. T{} es
+// el struct en cero
+vector<string> GoCodeGen::literal_fields(StructLiteralExp* lit, const StructInfo& sinfo) {
+    if (lit->values.empty()) return {};
+    if (lit->fields.empty()) {
+        if (lit->values.size() > sinfo.field_order.size()) {
+            throw runtime_error("Demasiados valores en el literal de '" + lit->typeName + "'.");
         }
-        
-        for (auto it = exp->args.rbegin(); it != exp->args.rend(); ++it) {
-            (*it)->accept(this);
-            output << "  pushq %rax" << endl;
+        if (lit->values.size() < sinfo.field_order.size()) {
+            throw runtime_error("Faltan valores en el literal de '" + lit->typeName + "'.");
         }
-        
-        output << "  call " << exp->funcName << endl;
-        
-        if (!exp->args.empty()) {
-            output << "  addq $" << exp->args.size() * 8 << ", %rsp" << endl;
+        return sinfo.field_order;
+    }
+    vector<string> fields(lit->fields.begin(), lit->fields.end());
+    set<string> seen;
+    for (auto& name : fields) {
+        if (!sinfo.fields.count(name)) {
+            throw runtime_error("Struct '" + lit->typeName + "' no tiene campo '" + name + "'.");
+        }
+        if (!seen.insert(name).second) {
+            throw runtime_error("Campo '" + name + "' repetido en el literal de '" + lit->typeName + "'.");
         }
-        
-        return ImpValue(env.get_function(exp->funcName).return_type);
     }
+    return fields;
 }
 
-ImpValue GoCodeGen::visit(FieldAccessExp* exp) {
-    IdentifierExp* obj_id = dynamic_cast<IdentifierExp*>(exp->object);
-    if (!obj_id) throw runtime_error("Acceso a campos solo en variables.");
-    
-    VarInfo var_info = env.lookup(obj_id->name);
-    if (var_info.struct_name.empty()) throw runtime_error("Variable no es un struct.");
-    
-    StructInfo sinfo = env.get_struct(var_info.struct_name);
-    if (sinfo.offsets.find(exp->field) == sinfo.offsets.end()) {
-        throw runtime_error("Struct no tiene campo '" + exp->field + "'.");
+// Divide %rax por %rcx; el resto queda en %rax si 'remainder'. Un divisor cero salta a
+// _panic_divide en lugar de dejar que idivq mate al programa con SIGFPE
+void GoCodeGen::emit_division(Exp* divisor, bool remainder) {
+    auto num = dynamic_cast<NumberExp*>(divisor);
+    if (!num || num->value == 0) {
+        needs_divide_check = true;
+        output << "  testq %rcx, %rcx" << endl;
+        output << "  je _panic_divide" << endl;
     }
-    int field_offset = sinfo.offsets.at(exp->field);
-    
-    int total_offset = var_info.offset + field_offset;
-    output << "  movq " << total_offset << "(%rbp), %rax" << endl;
+    output << "  cqto" << endl;
+    output << "  idivq %rcx" << endl;
+    if (remainder) output << "  movq %rdx, %rax" << endl;
+}
 
-    return ImpValue(sinfo.fields.at(exp->field).type);
+// Escribe los valores de un literal en el struct ubicado en 'base' del marco
+void GoCodeGen::store_struct_literal(StructLiteralExp* lit, const StructPlace& base) {
+    if (!env.has_struct(lit->typeName)) {
+        throw runtime_error("Uso de tipo struct no definido en un literal.");
+    }
+    StructInfo sinfo = env.get_struct(lit->typeName);
+    vector<string> fields = literal_fields(lit, sinfo);
+    // Los campos que un literal con claves omite quedan en cero
+    if (fields.size() < sinfo.field_order.size()) emit_zero(base, sinfo.size);
+
+    auto value_it = lit->values.begin();
+    for (size_t i = 0; i < lit->values.size(); i++, ++value_it) {
+        const FieldInfo& finfo = sinfo.fields.at(fields[i]);
+        if (!finfo.struct_name.empty()) {
+            store_struct_value(*value_it, base.at(finfo.offset), finfo.struct_name);
+            continue;
+        }
+        (*value_it)->accept(this);
+        emit_store(base.at(finfo.offset), finfo.size);
+    }
+}
+
+// Los structs se asignan por valor: un literal se escribe campo por campo, el
+// resultado de una llamada se recibe directamente en el destino y cualquier otro
+// valor se copia entero desde su ubicación
+// Un slot del marco que todavía no es una variable (la de un ':=' o un temporal) no
+// aparece en los mapas del recolector: mientras se arma el valor, los strings que ya
+// se escribieron en él se anotan como raíces
+void GoCodeGen::store_new_struct(Exp* value, int offset, const string& struct_name) {
+    size_t pending = pointer_temps.size();
+    if (!frame_omitted) string_words(struct_name, offset, pointer_temps);
+    store_struct_value(value, offset, struct_name);
+    pointer_temps.resize(pending);
+}
+
+void GoCodeGen::store_struct_value(Exp* value, const StructPlace& dest, const string& struct_name) {
+    string src_struct = struct_type_of(value);
+    if (src_struct.empty()) {
+        throw runtime_error("Se esperaba un valor de tipo '" + struct_name + "'.");
+    }
+    if (src_struct != struct_name) {
+        throw runtime_error("No se puede asignar un '" + src_struct + "' a un '" + struct_name + "'.");
+    }
+    int size = env.get_struct(struct_name).size;
+    if (auto lit = dynamic_cast<StructLiteralExp*>(value)) {
+        store_struct_literal(lit, dest);
+    } else if (auto call = dynamic_cast<FunctionCallExp*>(value)) {
+        if (struct_regs(struct_name) == 0) {
+            generate_user_call(call, &dest);
+        } else {
+            generate_user_call(call, nullptr);
+            emit_store_bytes(false, dest, min(size, 8));
+            if (size > 8) emit_store_bytes(true, dest.at(8), size - 8);
+        }
+    } else {
+        int src;
+        struct_location(value, src, src_struct);
+        emit_copy(dest, src, size);
+    }
+}
+
+string GoCodeGen::struct_type_of(Exp* exp) {
+    if (auto lit = dynamic_cast<StructLiteralExp*>(exp)) return lit->typeName;
+    if (auto call = dynamic_cast<FunctionCallExp*>(exp)) {
+        return env.has_function(call->funcName) ? env.get_function(call->funcName).return_struct : "";
+    }
+    int offset;
+    string struct_name;
+    if (dynamic_cast<IdentifierExp*>(exp) || dynamic_cast<FieldAccessExp*>(exp)) {
+        struct_location(exp, offset, struct_name);
+    }
+    return struct_name;
 }
 
 ImpValue GoCodeGen::visit(StructLiteralExp* exp) {
@@ -603,5 +2983,83 @@ ImpValue GoCodeGen::visit(StructLiteralExp* exp) {
     return val;
 }
 
-ImpValue GoCodeGen::visit(IndexExp* exp) { return ImpValue(); }
-ImpValue GoCodeGen::visit(SliceExp* exp) { return ImpValue(); }
\ No newline at end of file
+// s[i] es el byte i (un int entre 0 y 255). El índice se compara sin signo con el
+// largo, así que un negativo también cae en el salto a _panic_index, que queda fuera
+// del camino normal (el salto hacia adelante no se toma).
+ImpValue GoCodeGen::visit(IndexExp* exp) {
+    auto str = dynamic_cast<StringExp*>(exp->array);
+    auto num = dynamic_cast<NumberExp*>(exp->index);
+    if (str && num) {
+        if (num->value < 0 || num->value >= (long)str->value.size()) {
+            throw runtime_error("Índice " + to_string(num->value) + " fuera del string de largo " +
+                                to_string(str->value.size()) + ".");
+        }
+        output << "  movq $" << (int)(unsigned char)str->value[num->value] << ", %rax" << endl;
+        return ImpValue(TINT);
+    }
+
+    ImpValue array = exp->array->accept(this);
+    if (array.type != TSTRING) throw runtime_error("Solo se pueden indexar strings.");
+    this->needs_bounds_checks = true;
+    if (is_direct_operand(exp->index)) {
+        output << "  movq %rax, %rcx" << endl;
+        load_direct(exp->index, "%rax", "");
+    } else {
+        push_reg("%rdx");
+        push_reg("%rax", true);
+        exp->index->accept(this);
+        pop_reg("%rcx");
+        pop_reg("%rdx");
+    }
+    output << "  cmpq %rdx, %rax" << endl;
+    output << "  jae _panic_index" << endl;
+    output << "  movzbq (%rcx,%rax), %rax" << endl;
+    return ImpValue(TINT);
+}
+
+// s[a:b] es una vista (puntero + a, b - a) de los mismos bytes: no reserva ni copia.
+// Se exige a <= b <= len(s) sin signo; si no, _panic_slice_high (b > largo) o
+// _panic_slice_low (a > b).
+ImpValue GoCodeGen::visit(SliceExp* exp) {
+    ImpValue array = exp->array->accept(this);
+    if (array.type != TSTRING) throw runtime_error("Solo se pueden tomar substrings de strings.");
+    this->needs_bounds_checks = true;
+    bool direct = (!exp->start || is_direct_operand(exp->start)) && (!exp->end || is_direct_operand(exp->end));
+    if (direct) {
+        output << "  movq %rax, %r11" << endl;
+    } else {
+        push_reg("%rdx");
+        push_reg("%rax", true);
+    }
+    // a en %rax, b en %rcx, largo en %rdx y puntero en %r11
+    if (direct) {
+        if (exp->end) load_direct(exp->end, "%rcx", "");
+        else output << "  movq %rdx, %rcx" << endl;
+        if (exp->start) load_direct(exp->start, "%rax", "");
+        else output << "  xorl %eax, %eax" << endl;
+    } else {
+        if (exp->start) exp->start->accept(this);
+        else output << "  xorl %eax, %eax" << endl;
+        if (exp->end) {
+            push_reg("%rax");
+            exp->end->accept(this);
+            output << "  movq %rax, %rcx" << endl;
+            pop_reg("%rax");
+        }
+        pop_reg("%r11");
+        pop_reg("%rdx");
+        if (!exp->end) output << "  movq %rdx, %rcx" << endl;
+    }
+    if (exp->end) {
+        output << "  cmpq %rdx, %rcx" << endl;
+        output << "  ja _panic_slice_high" << endl;
+    }
+    if (exp->start) {
+        output << "  cmpq %rcx, %rax" << endl;
+        output << "  ja _panic_slice_low" << endl;
+    }
+    output << "  movq %rcx, %rdx" << endl;
+    output << "  subq %rax, %rdx" << endl;
+    output << "  addq %r11, %rax" << endl;
+    return ImpValue(TSTRING);
+}
\ No newline at end of file
@@ -2,38 +2,227 @@
 #define GENCODE_H
 
 #include <unordered_map>
+#include <map>
+#include <set>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <vector>
 #include "exp.h"
 #include "imp_value_visitor.h"
 #include "environment.hh"
+#include "options.h"
+#include "escape.h"
 
 using namespace std;
 class StringCollectorVisitor;
+
+// Lugar donde se escribe un struct: 'offset' en el marco o, si pointer_slot no es 0,
+// 'offset' bytes después de la dirección guardada en ese slot del marco (el destino
+// que pasa el llamador para un struct devuelto por memoria)
+struct StructPlace {
+    int offset;
+    int pointer_slot;
+    StructPlace(int offset, int pointer_slot = 0) : offset(offset), pointer_slot(pointer_slot) {}
+    StructPlace at(int delta) const { return StructPlace(offset + delta, pointer_slot); }
+};
+
+// Dónde viaja un argumento según System V: en 'regs' registros desde ARG_REGS[reg],
+// o en la pila en 'stack_offset' del área de argumentos (reg == -1). Un string es
+// un par (puntero, largo) y viaja como un struct de dos registros.
+struct ArgSlot {
+    int reg;
+    int regs;
+    int stack_offset;
+    string struct_name;
+    bool is_string;
+};
+
+// Sitio de llamada que puede llegar a _go_alloc: etiqueta en la dirección de retorno
+// y offsets respecto de %rbp de los slots que guardan punteros de strings
+struct GcSite {
+    string label;
+    vector<int> offsets;
+};
+// Variable global: vive en 'label' (.data si tiene valor inicial conocido en
+// compilación, .bss si no) y los accesos la ven en 'offset', desde GLOBAL_BASE, así
+// frame_slot la direcciona respecto de %rip. 'image' es el contenido inicial como
+// pares (offset dentro de la variable, directiva), ordenados; vacío si es todo cero.
+struct GlobalVar {
+    string label;
+    int offset;
+    int size;
+    vector<pair<int, string>> image;
+};
+
 class GoCodeGen : public ImpValueVisitor {
 private:
     Environment env;
     int current_offset;
     std::unordered_map<std::string, std::string> string_literals;
+    // Literales que el código generado referencia
+    set<string> used_literals;
     int label_counter;
     int string_counter;
     std::ostream& output;
+    CompilerOptions options;
     string current_epilogue_label;
+    // Función en generación y etiqueta posterior al guardado de sus parámetros,
+    // adonde salta la recursión de cola
+    FuncDecl* current_function;
+    string current_entry_label;
+    vector<int> current_param_offsets;
+    // Slot con la dirección donde la función actual escribe su struct de retorno (0 si no hay)
+    int sret_slot;
+    // Bytes apilados con push desde que se armó el marco; el marco deja %rsp
+    // alineado a 16, así que la pila está alineada cuando este valor es múltiplo de 16
+    int stack_depth;
+    int max_stack_depth;
+    // Bytes de locales y parámetros guardados de la función actual
+    int frame_size;
+    // La función actual llamó a algo (no es hoja) / se genera sin marco (red zone)
+    bool made_call;
+    bool frame_omitted;
+    // Alcances del cálculo del marco: variable -> tipo (el offset no se usa)
+    vector<map<string, VarInfo>> sizing_scopes;
+    // Variables de la función actual que acumulan con s += e dentro de un bucle; si
+    // son strings locales llevan un slot extra con la capacidad de su buffer
+    set<string> string_builders;
+    // Acumuladores cuyo valor no escapa: empiezan con un buffer del marco
+    set<string> stack_builders;
+    // Concatenaciones que no escapan y el offset de su buffer en el marco, y el
+    // comienzo del área de temporales de la función actual
+    EscapeAnalyzer escapes;
+    map<Exp*, int> stack_buffers;
+    int temp_area;
 
     // Banderas para la generación condicional de helpers
     bool needs_string_concat;
     bool needs_string_compare;
+    bool needs_string_append;
+    bool needs_string_concat_n;
+    bool needs_bounds_checks;
+    bool needs_divide_check;
+    // El programa imprime con fmt.Println y se usa el buffer de salida
+    bool needs_output_buffer;
+    // Mapas de raíces para el recolector, y offsets respecto de %rbp de los
+    // temporales de la pila (y de los structs que se están armando en el marco)
+    // que tienen el puntero de un string
+    vector<GcSite> gc_sites;
+    vector<int> pointer_temps;
+    // Globales en orden de offset, su tipo para el cálculo de los marcos y los
+    // offsets de sus punteros de strings (raíces permanentes del recolector)
+    vector<GlobalVar> globals;
+    map<string, VarInfo> global_vars;
+    vector<int> global_roots;
 
     string new_label();
+    // Genera un salto a 'target' si la condición evalúa a 'jump_if' (contexto de salto)
+    void generate_condition(Exp* cond, bool jump_if, const string& target);
+    static string jump_for(BinaryOp op, bool jump_if);
+    // push/pop que llevan la cuenta de stack_depth; 'pointer' anota el valor apilado
+    // como raíz para el recolector
+    void push_reg(const string& reg, bool pointer = false);
+    void pop_reg(const string& reg);
+    // Offsets de los punteros de strings de un struct ubicado en 'base'
+    void string_words(const string& struct_name, int base, vector<int>& out);
+    // Anota como raíces los punteros de un área recién reservada en el tope de la pila
+    void note_pointer_area(const vector<int>& offsets);
+    // Olvida los temporales que ya no están en la pila
+    void release_pointer_temps();
+    // Etiqueta la dirección de retorno de la llamada recién emitida y guarda su mapa
+    void record_gc_site();
+    // call que garantiza %rsp alineado a 16 en el punto de llamada (System V)
+    void emit_call(const string& target);
+    // Accesos a memoria según el tamaño del valor: bool ocupa 1 byte y un string 16
+    // (puntero en 'reg' o %rax, largo en 'reg2' o %rdx)
+    void emit_load(int offset, int size, const string& reg, const string& reg2 = "%rdx");
+    void emit_store(const StructPlace& dest, int size);
+    // Puesta a cero y copia de bloques del marco (SSE2, o rep stosq/movsq si son grandes)
+    void emit_zero(const StructPlace& dest, int size);
+    void emit_copy(const StructPlace& dest, int src, int size);
+    // Guarda los 'size' bytes bajos de %rax (o %rdx) sin pisar lo que sigue
+    void emit_store_bytes(bool from_rdx, const StructPlace& dest, int size);
+    string place_operand(const StructPlace& place);
+    void load_place_address(const StructPlace& place, const string& reg);
+    // Offset respecto de %rbp de la dirección apuntada por %rsp en este punto
+    int stack_top_offset();
+    void field_location(FieldAccessExp* exp, int& offset, FieldInfo& finfo);
+    // Ubicación en el marco de una expresión de tipo struct; false si no es un lugar
+    bool struct_location(Exp* exp, int& offset, string& struct_name);
+    // Campo al que va cada valor de un literal (por clave o por posición)
+    vector<string> literal_fields(StructLiteralExp* lit, const StructInfo& sinfo);
+    void store_struct_literal(StructLiteralExp* lit, const StructPlace& base);
+    // idivq %rcx precedido del chequeo de divisor cero, salvo que 'divisor' sea una
+    // constante distinta de cero
+    void emit_division(Exp* divisor, bool remainder);
+    // Escribe un valor struct (literal, copia o resultado de una llamada) en 'dest'
+    void store_struct_value(Exp* value, const StructPlace& dest, const string& struct_name);
+    // store_struct_value en un slot del marco que aún no es una variable
+    void store_new_struct(Exp* value, int offset, const string& struct_name);
+    // Struct al que evalúa una expresión ("" si es escalar), sin generar código
+    string struct_type_of(Exp* exp);
+    // Registros que ocupa un struct por valor: 1 o 2 si mide hasta 16 bytes, 0 si va por memoria
+    int struct_regs(const string& struct_name);
+    vector<ArgSlot> layout_args(const vector<ImpVType>& arg_types, const vector<string>& arg_structs,
+                                bool sret, int& stack_bytes);
+    // Llamada a una función del programa; un struct devuelto por memoria se escribe en 'sret'
+    ImpValue generate_user_call(FunctionCallExp* call, const StructPlace* sret);
+    VarInfo sizing_var(const string& name);
+    VarInfo sizing_info_of(Exp* exp);
+    int value_bytes(const VarInfo& info);
+    // Con el string izquierdo en %rax:%rdx evalúa el derecho y deja ambos como
+    // argumentos de _concat_strings/_equal_strings
+    void string_call_operands(Exp* right);
+    bool short_literal_operand(BinaryExp* exp, Exp*& other, string& literal);
+    void emit_literal_equality(Exp* other, const string& literal, const string& mismatch);
+    // Con el string a agregar en %rax:%rdx, lo agrega al acumulador en 'offset'
+    void emit_string_append(int offset);
+    // Carga un literal (registrándolo si es nuevo) en %rax:%rdx
+    void emit_string_literal(const string& value);
+    string string_label(const string& value);
+    bool is_string_exp(Exp* e);
+    // Concatenación de varias piezas con una sola reserva; el resultado queda en %rax:%rdx
+    // 'buffer' es el offset de un buffer del marco donde escribirla si entra (0: heap)
+    void generate_concat(const vector<Exp*>& pieces, int buffer = 0);
+    // Offset del buffer del marco de una concatenación que no escapa (0 si no tiene)
+    int stack_buffer_of(Exp* e);
+    // Acumulador que empieza con un buffer del marco: no escapa y se inicializa con ""
+    bool stack_builder(const string& name, Exp* init);
+    void find_string_builders(FuncDecl* decl);
+    // Argumentos que se pueden cargar directamente en su registro con una instrucción
+    bool is_direct_operand(Exp* e);
+    void load_direct(Exp* e, const string& reg, const string& reg2 = "%rdx");
+    int generate_call_args(const list<Exp*>& args, const FuncInfo& callee, const StructPlace* sret = nullptr);
+    void generate_function(FuncDecl* decl);
+    // Operando de memoria para un offset del marco (%rbp, o %rsp sin marco) o de una global
+    string frame_slot(int offset);
+    static bool is_global_slot(int offset);
+    // Etiqueta y desplazamiento de un offset de una global ("global_x+8")
+    string global_address(int offset);
+    // Ubica las globales y devuelve las asignaciones de las que no se inicializan en compilación
+    list<Stmt*> layout_globals(Program* program);
+    // Contenido inicial de un valor constante de tipo 'info' en 'base'; false si no es constante
+    bool constant_image(Exp* value, const VarInfo& info, int base, vector<pair<int, string>>& image,
+                        const map<string, Exp*>& known);
+    void generate_globals();
+    // return f(...) como salto reutilizando el marco; false si no aplica
+    bool generate_tail_call(FunctionCallExp* call);
     void generate_prologue();
     void generate_epilogue();
     void generate_string_literals();
     void generate_runtime_helpers();
+    void generate_output_runtime();
+    void generate_alloc_runtime();
+    // -falloc-stats con el reservador propio: main reporta las reservas al terminar
+    bool report_allocs() const { return options.alloc_stats && options.arena_alloc; }
+    bool gc_enabled() const { return options.gc && options.arena_alloc; }
+    void generate_gc_runtime();
+    void generate_println(const list<Exp*>& args);
     int calculate_stack_size(Program* p);
 
 public:
-    GoCodeGen(std::ostream& out = std::cout);
+    GoCodeGen(std::ostream& out = std::cout, const CompilerOptions& opts = CompilerOptions());
     void generateCode(Program* program);
     
     // Visitantes de expresiones
@@ -58,6 +247,7 @@ public:
     void visit(ForStmt* stmt) override;
     void visit(ReturnStmt* stmt) override;
     void visit(VarDecl* stmt) override;
+    void visit(BlockStmt* stmt) override;
     
     // Visitantes de declaraciones
     void visit(TypeDecl* decl) override;
@@ -67,8 +257,9 @@ public:
     void visit(Program* program) override;
 
     // Métodos para el cálculo de tamaño de stack (helpers)
-    int calculate_block_size(Block* block);
-    int calculate_stmt_size(Stmt* stmt);
+    int calculate_function_size(FuncDecl* decl, bool reuse_slots = true);
+    int calculate_block_size(Block* block, bool reuse_slots = true);
+    int calculate_stmt_size(Stmt* stmt, bool reuse_slots = true);
 };
 
 #endif
\ No newline at end of file
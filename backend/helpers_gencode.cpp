@@ -2,6 +2,8 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include "exp.h"
 #include "imp_value_visitor.h"
 #include "visitor.h"
@@ -34,6 +36,7 @@ public:
     void visit(AssignStmt* stmt) override { if(stmt->lhs) stmt->lhs->accept(this); if(stmt->rhs) stmt->rhs->accept(this); }
     void visit(ExprStmt* stmt) override { if(stmt->expression) stmt->expression->accept(this); }
     void visit(ReturnStmt* stmt) override { if(stmt->expression) stmt->expression->accept(this); }
+    void visit(BlockStmt* stmt) override { if(stmt->block) stmt->block->accept(this); }
     ImpValue visit(FunctionCallExp* exp) override { for(auto arg : exp->args) if (arg) arg->accept(this); return ImpValue(); }
     ImpValue visit(NumberExp* exp) override { return ImpValue(); }
     ImpValue visit(BoolExp* exp) override { return ImpValue(); }
@@ -47,43 +50,101 @@ public:
     void visit(ImportDecl* decl) override {}
 };
 
+// Tamaño (y alineación) natural de un valor escalar en memoria
+static int basic_type_size(ImpVType type) {
+    switch (type) {
+        case TBOOL: return 1;
+        case TSTRING: return 16; // Puntero y largo
+        default: return 8;
+    }
+}
+
+// Calcula el layout de cada struct: cada campo ocupa su tamaño natural alineado a
+// su alineación (bool 1 byte, int y string 8, structs anidados según su propio
+// layout) y el tamaño total se redondea a la alineación del struct. Con
+// reorder_fields los campos se ubican de mayor a menor alineación para minimizar el
+// relleno; los literales siguen usando el orden de declaración (field_order).
 class StructCollectorVisitor : public Visitor {
 public:
     Environment& env;
-    StructCollectorVisitor(Environment& env) : env(env) {}
+    bool reorder_fields;
+    unordered_map<string, TypeDecl*> declarations;
+    unordered_map<string, bool> in_progress;
+    StructCollectorVisitor(Environment& env, bool reorder = false) : env(env), reorder_fields(reorder) {}
 
     void visit(Program* program) override {
+        // Un struct puede usar como campo a otro declarado más adelante
+        for (auto type_decl : program->types) {
+            declarations[type_decl->name] = type_decl;
+        }
         for (auto type_decl : program->types) {
             type_decl->accept(this);
         }
     }
 
     void visit(TypeDecl* decl) override {
+        if (env.has_struct(decl->name)) return;
+        if (in_progress[decl->name]) {
+            throw runtime_error("Struct recursivo: '" + decl->name + "' se contiene a sí mismo.");
+        }
+        in_progress[decl->name] = true;
+
         StructInfo sinfo;
         sinfo.name = decl->name;
-        int current_offset = 0;
         
         if (auto st = dynamic_cast<StructType*>(decl->structType)) {
             for (auto field_pair : st->fields) {
                 string field_name = field_pair.first;
                 Type* field_type_node = field_pair.second;
+                if (sinfo.fields.count(field_name)) {
+                    throw runtime_error("Campo duplicado '" + field_name + "' en el struct '" + decl->name + "'.");
+                }
                 
                 FieldInfo finfo;
+                finfo.offset = 0;
                 if (auto bt = dynamic_cast<BasicType*>(field_type_node)) {
                     finfo.type_name = bt->typeName;
                     finfo.type = ImpValue::get_basic_type(bt->typeName);
-                    finfo.size = 8;
+                    finfo.size = basic_type_size(finfo.type);
+                    finfo.align = min(finfo.size, 8);
+                } else if (auto id_type = dynamic_cast<IdentifierType*>(field_type_node)) {
+                    if (declarations.count(id_type->name)) declarations[id_type->name]->accept(this);
+                    if (!env.has_struct(id_type->name)) {
+                        throw runtime_error("Tipo de campo desconocido '" + id_type->name + "'.");
+                    }
+                    StructInfo nested = env.get_struct(id_type->name);
+                    finfo.type_name = id_type->name;
+                    finfo.type = NOTYPE;
+                    finfo.struct_name = id_type->name;
+                    finfo.size = nested.size;
+                    finfo.align = nested.align;
                 } else {
-                     throw runtime_error("Structs anidados o tipos complejos no soportados.");
+                     throw runtime_error("Tipo de campo no soportado en struct.");
                 }
 
                 sinfo.fields[field_name] = finfo;
-                sinfo.offsets[field_name] = current_offset;
-                current_offset += finfo.size;
+                sinfo.field_order.push_back(field_name);
             }
         }
-        sinfo.size = current_offset;
+
+        vector<string> placement = sinfo.field_order;
+        if (reorder_fields) {
+            stable_sort(placement.begin(), placement.end(), [&](const string& a, const string& b) {
+                return sinfo.fields[a].align > sinfo.fields[b].align;
+            });
+        }
+        int current_offset = 0;
+        for (auto& field_name : placement) {
+            FieldInfo& finfo = sinfo.fields[field_name];
+            current_offset = (current_offset + finfo.align - 1) / finfo.align * finfo.align;
+            finfo.offset = current_offset;
+            sinfo.offsets[field_name] = current_offset;
+            current_offset += finfo.size;
+            sinfo.align = max(sinfo.align, finfo.align);
+        }
+        sinfo.size = (current_offset + sinfo.align - 1) / sinfo.align * sinfo.align;
         env.add_struct(decl->name, sinfo);
+        in_progress[decl->name] = false;
     }
     
     void visit(BinaryExp* exp) override {} void visit(UnaryExp* exp) override {} void visit(NumberExp* exp) override {}
@@ -93,6 +154,6 @@ public:
     void visit(StructType* type) override {} void visit(IdentifierType* type) override {} void visit(ExprStmt* stmt) override {}
     void visit(AssignStmt* stmt) override {} void visit(ShortVarDecl* stmt) override {} void visit(IncDecStmt* stmt) override {}
     void visit(IfStmt* stmt) override {} void visit(ForStmt* stmt) override {} void visit(ReturnStmt* stmt) override {}
-    void visit(VarDecl* stmt) override {} void visit(FuncDecl* decl) override {} void visit(Block* block) override {}
+    void visit(VarDecl* stmt) override {} void visit(BlockStmt*) override {} void visit(FuncDecl* decl) override {} void visit(Block* block) override {}
     void visit(ImportDecl* decl) override {}
 };
\ No newline at end of file
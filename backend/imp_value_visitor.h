@@ -24,6 +24,7 @@ class IfStmt;
 class ForStmt;
 class ReturnStmt;
 class VarDecl;
+class BlockStmt;
 
 class TypeDecl;
 class FuncDecl;
@@ -53,6 +54,7 @@ public:
     virtual void visit(ForStmt* stmt) = 0;
     virtual void visit(ReturnStmt* stmt) = 0;
     virtual void visit(VarDecl* stmt) = 0;
+    virtual void visit(BlockStmt* stmt) = 0;
     
     virtual void visit(TypeDecl* decl) = 0;
     virtual void visit(FuncDecl* decl) = 0;
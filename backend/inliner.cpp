@@ -0,0 +1,371 @@
+#include "inliner.h"
+#include <functional>
+#include "ast_utils.h"
+
+using namespace std;
+
+Inliner::Inliner(const CompilerOptions& opts)
+    : options(opts), current(nullptr), temp_counter(0), inlined_exp_count(0), inlined_stmt_count(0) {}
+
+string Inliner::new_temp(const string& prefix) {
+    return "inl$" + prefix + to_string(temp_counter++);
+}
+
+//=== GRAFO DE LLAMADAS ===
+static void collect_calls(Block* body, const map<string, FuncDecl*>& functions, set<string>& callees) {
+    set<string> names;
+    collect_called_functions(body, names);
+    for (auto& name : names) {
+        if (functions.count(name)) callees.insert(name);
+    }
+}
+
+void Inliner::build_call_graph(Program* program) {
+    for (auto func : program->functions) functions[func->name] = func;
+    for (auto func : program->functions) collect_calls(func->body, functions, call_graph[func->name]);
+}
+
+// Una función es recursiva si puede alcanzarse a sí misma en el grafo de llamadas
+void Inliner::find_recursive() {
+    for (auto& entry : call_graph) {
+        set<string> seen;
+        vector<string> pending(entry.second.begin(), entry.second.end());
+        while (!pending.empty()) {
+            string name = pending.back();
+            pending.pop_back();
+            if (name == entry.first) {
+                recursive.insert(name);
+                break;
+            }
+            if (!seen.insert(name).second) continue;
+            for (auto& callee : call_graph[name]) pending.push_back(callee);
+        }
+    }
+}
+
+// true si el llamado usa una global que en el llamador actual tapa una local o un
+// parámetro con el mismo nombre
+bool Inliner::shadows_global(FuncDecl* callee) {
+    set<string> used;
+    collect_modified_vars(callee->body, used);
+    rewrite_block_exps(callee->body, [&](Exp* e) -> Exp* {
+        if (auto id = dynamic_cast<IdentifierExp*>(e)) used.insert(id->name);
+        return nullptr;
+    });
+    set<string> declared;
+    for (auto& param : current->params) declared.insert(param.first);
+    collect_declared_vars(current->body, declared);
+    for (auto& name : used) {
+        if (globals.count(name) && declared.count(name)) return true;
+    }
+    return false;
+}
+
+static bool is_struct_type(Type* t) {
+    return dynamic_cast<IdentifierType*>(t) != nullptr;
+}
+
+bool Inliner::can_inline(FuncDecl* callee) {
+    if (callee == current || callee->name == "main" || recursive.count(callee->name)) return false;
+    if (!globals.empty() && shadows_global(callee)) return false;
+    // Los temporales de argumentos y resultado son escalares: solo se expanden funciones escalares
+    if (is_struct_type(callee->returnType)) return false;
+    for (auto& param : callee->params) {
+        if (is_struct_type(param.second)) return false;
+    }
+
+    set<string> callees;
+    collect_calls(callee->body, functions, callees);
+    int limit = callees.empty() ? options.inline_limit : options.inline_limit / 2;
+    return count_nodes(callee->body) <= limit;
+}
+
+void Inliner::record(FuncDecl* callee, const string& kind) {
+    report.push_back(callee->name + " en " + current->name + " (" + kind + ", costo " +
+                     to_string(count_nodes(callee->body)) + ")");
+}
+
+//=== EXPANSIÓN COMO EXPRESIÓN ===
+static int count_uses(Exp* e, const string& name) {
+    int uses = 0;
+    rewrite_exp(e, [&](Exp* sub) -> Exp* {
+        auto id = dynamic_cast<IdentifierExp*>(sub);
+        if (id && id->name == name) uses++;
+        return nullptr;
+    });
+    return uses;
+}
+
+// Usos de 'name' en el operando derecho de un && o ||, que puede no evaluarse
+static int conditional_uses(Exp* e, const string& name) {
+    int uses = 0;
+    rewrite_exp(e, [&](Exp* sub) -> Exp* {
+        auto bin = dynamic_cast<BinaryExp*>(sub);
+        if (bin && (bin->op == AND_OP || bin->op == OR_OP)) uses += count_uses(bin->right, name);
+        return nullptr;
+    });
+    return uses;
+}
+
+static bool is_leaf_exp(Exp* e) {
+    return dynamic_cast<IdentifierExp*>(e) || dynamic_cast<NumberExp*>(e) ||
+           dynamic_cast<StringExp*>(e) || dynamic_cast<BoolExp*>(e) ||
+           dynamic_cast<FieldAccessExp*>(e);
+}
+
+Exp* Inliner::inline_exp(FunctionCallExp* call) {
+    auto it = functions.find(call->funcName);
+    if (it == functions.end() || !can_inline(it->second)) return nullptr;
+    FuncDecl* callee = it->second;
+    if (call->args.size() != callee->params.size() || callee->body->statements.size() != 1) return nullptr;
+    auto ret = dynamic_cast<ReturnStmt*>(callee->body->statements.front());
+    if (!ret || !ret->expression) return nullptr;
+
+    // Los argumentos se evalúan en el orden en que e use los parámetros. Eso solo es
+    // equivalente si a lo sumo un argumento tiene efectos, aparece exactamente una
+    // vez y e no tiene efectos propios. Los argumentos puros que se usan varias veces
+    // se duplican, así que solo se aceptan si son triviales. Uno que no se usa, o que
+    // solo se usa donde puede no evaluarse, desaparece o puede saltarse, y eso solo
+    // vale si no tiene efectos ni puede fallar (f(x/0) tiene que fallar igual): si no,
+    // la llamada queda para la expansión como bloque, que lo evalúa al ligarlo.
+    bool body_pure = is_pure_exp(ret->expression);
+    int impure_args = 0;
+    map<string, Exp*> bindings;
+    auto arg_it = call->args.begin();
+    for (auto& param : callee->params) {
+        Exp* arg = *arg_it++;
+        int uses = count_uses(ret->expression, param.first);
+        // Un uso a la derecha de && o || puede no evaluarse (c && a > 0 con c falso),
+        // y el argumento tiene que correr igual
+        bool maybe_skipped = uses == 0 || conditional_uses(ret->expression, param.first) > 0;
+        if (!is_pure_exp(arg)) {
+            if (uses != 1 || maybe_skipped || !body_pure || ++impure_args > 1) return nullptr;
+        } else if ((uses > 1 && !is_leaf_exp(arg)) || (maybe_skipped && !cannot_fail(arg))) {
+            return nullptr;
+        }
+        bindings[param.first] = arg;
+    }
+
+    Exp* result = rewrite_exp(clone_exp(ret->expression), [&](Exp* e) -> Exp* {
+        auto id = dynamic_cast<IdentifierExp*>(e);
+        if (!id || !bindings.count(id->name)) return nullptr;
+        Exp* arg = clone_exp(bindings[id->name]);
+        delete e;
+        return arg;
+    });
+    record(callee, "expresión");
+    inlined_exp_count++;
+    return result;
+}
+
+//=== EXPANSIÓN COMO BLOQUE ===
+// 'if c { ...; return a }; resto' pasa a 'if c { ...; return a } else { resto }'
+// (y lo simétrico si la rama que retorna es el else); lo que sigue a una sentencia
+// que siempre retorna se descarta por inalcanzable
+static void normalize_returns(Block* b) {
+    if (!b) return;
+    auto& stmts = b->statements;
+    for (auto it = stmts.begin(); it != stmts.end(); ++it) {
+        auto rest = next(it);
+        auto is = dynamic_cast<IfStmt*>(*it);
+        bool then_returns = is && always_returns(is->thenBlock);
+        bool else_returns = is && always_returns(is->elseBlock);
+        if (dynamic_cast<ReturnStmt*>(*it) || (then_returns && else_returns)) {
+            for (auto dead = rest; dead != stmts.end(); ++dead) delete *dead;
+            stmts.erase(rest, stmts.end());
+        } else if ((then_returns || else_returns) && rest != stmts.end()) {
+            Block*& target = then_returns ? is->elseBlock : is->thenBlock;
+            if (!target) target = new Block(list<Stmt*>());
+            target->statements.insert(target->statements.end(), rest, stmts.end());
+            stmts.erase(rest, stmts.end());
+        }
+        if (is) {
+            normalize_returns(is->thenBlock);
+            normalize_returns(is->elseBlock);
+        } else if (auto bs = dynamic_cast<BlockStmt*>(*it)) {
+            normalize_returns(bs->block);
+        }
+    }
+}
+
+// Sin goto ni break, un return solo puede traducirse a una asignación si es lo último
+// que ejecuta la función
+static bool returns_in_tail(Block* b, bool tail) {
+    if (!b) return true;
+    for (auto it = b->statements.begin(); it != b->statements.end(); ++it) {
+        bool last = tail && next(it) == b->statements.end();
+        if (dynamic_cast<ReturnStmt*>(*it)) {
+            if (!last) return false;
+        } else if (auto is = dynamic_cast<IfStmt*>(*it)) {
+            if (!returns_in_tail(is->thenBlock, last) || !returns_in_tail(is->elseBlock, last)) return false;
+        } else if (auto fs = dynamic_cast<ForStmt*>(*it)) {
+            if (!returns_in_tail(fs->body, false)) return false;
+        } else if (auto bs = dynamic_cast<BlockStmt*>(*it)) {
+            if (!returns_in_tail(bs->block, last)) return false;
+        }
+    }
+    return true;
+}
+
+// Reemplaza cada 'return e' por lo que construya 'f' a partir de e (nullptr: nada)
+static void rewrite_returns(Block* b, const function<Stmt*(Exp*)>& f) {
+    if (!b) return;
+    for (auto it = b->statements.begin(); it != b->statements.end();) {
+        if (auto rs = dynamic_cast<ReturnStmt*>(*it)) {
+            Stmt* replacement = f(rs->expression);
+            rs->expression = nullptr;
+            delete rs;
+            if (replacement) {
+                *it = replacement;
+                ++it;
+            } else {
+                it = b->statements.erase(it);
+            }
+            continue;
+        }
+        if (auto is = dynamic_cast<IfStmt*>(*it)) {
+            rewrite_returns(is->thenBlock, f);
+            rewrite_returns(is->elseBlock, f);
+        } else if (auto bs = dynamic_cast<BlockStmt*>(*it)) {
+            rewrite_returns(bs->block, f);
+        }
+        ++it;
+    }
+}
+
+bool Inliner::inline_stmt(Stmt* stmt, list<Stmt*>& expansion) {
+    FunctionCallExp* call = nullptr;
+    auto es = dynamic_cast<ExprStmt*>(stmt);
+    auto as = dynamic_cast<AssignStmt*>(stmt);
+    auto sv = dynamic_cast<ShortVarDecl*>(stmt);
+    auto rs = dynamic_cast<ReturnStmt*>(stmt);
+    if (es) call = dynamic_cast<FunctionCallExp*>(es->expression);
+    else if (as) call = dynamic_cast<FunctionCallExp*>(as->rhs);
+    else if (sv && sv->values.size() == 1) call = dynamic_cast<FunctionCallExp*>(sv->values.front());
+    else if (rs) call = dynamic_cast<FunctionCallExp*>(rs->expression);
+    if (!call) return false;
+
+    auto it = functions.find(call->funcName);
+    if (it == functions.end() || !can_inline(it->second)) return false;
+    FuncDecl* callee = it->second;
+    bool needs_value = !es;
+    if (call->args.size() != callee->params.size() || (needs_value && !callee->returnType)) return false;
+
+    Block* body = clone_block(callee->body);
+    normalize_returns(body);
+    if (!returns_in_tail(body, true)) {
+        delete body;
+        return false;
+    }
+
+    string result = needs_value ? new_temp("ret") : "";
+    rewrite_returns(body, [&](Exp* e) -> Stmt* {
+        if (needs_value) return new AssignStmt(new IdentifierExp(result), e, ASSIGN_OP);
+        if (e && (!is_pure_exp(e) || !cannot_fail(e))) return new ExprStmt(e);
+        delete e;
+        return nullptr;
+    });
+
+    // Si un argumento lee una variable con el nombre de un parámetro ya ligado,
+    // ligarlos directamente lo capturaría: en ese caso se evalúan antes en temporales
+    bool capture = false;
+    set<string> bound;
+    auto arg_it = call->args.begin();
+    for (auto& param : callee->params) {
+        set<string> used;
+        collect_used_vars(*arg_it++, used);
+        for (auto& name : used) capture = capture || bound.count(name);
+        bound.insert(param.first);
+    }
+
+    list<Stmt*> bindings;
+    arg_it = call->args.begin();
+    for (auto& param : callee->params) {
+        Exp* value = clone_exp(*arg_it++);
+        if (capture) {
+            string temp = new_temp("arg");
+            expansion.push_back(new ShortVarDecl({temp}, {value}));
+            value = new IdentifierExp(temp);
+        }
+        bindings.push_back(new ShortVarDecl({param.first}, {value}));
+    }
+    body->statements.insert(body->statements.begin(), bindings.begin(), bindings.end());
+
+    if (needs_value) expansion.push_back(new VarDecl({result}, clone_type(callee->returnType)));
+    expansion.push_back(new BlockStmt(body));
+    if (as) {
+        expansion.push_back(new AssignStmt(as->lhs, new IdentifierExp(result), as->op));
+        as->lhs = nullptr;
+    } else if (sv) {
+        expansion.push_back(new ShortVarDecl(sv->identifiers, {new IdentifierExp(result)}));
+    } else if (rs) {
+        expansion.push_back(new ReturnStmt(new IdentifierExp(result)));
+    }
+    record(callee, "bloque");
+    inlined_stmt_count++;
+    return true;
+}
+
+void Inliner::inline_block(Block* block) {
+    if (!block) return;
+    auto& stmts = block->statements;
+    for (auto it = stmts.begin(); it != stmts.end();) {
+        Stmt* stmt = *it;
+        if (auto is = dynamic_cast<IfStmt*>(stmt)) {
+            inline_block(is->thenBlock);
+            inline_block(is->elseBlock);
+        } else if (auto fs = dynamic_cast<ForStmt*>(stmt)) {
+            inline_block(fs->body);
+        } else if (auto bs = dynamic_cast<BlockStmt*>(stmt)) {
+            inline_block(bs->block);
+        }
+
+        list<Stmt*> expansion;
+        if (inline_stmt(stmt, expansion)) {
+            // Se sigue desde el inicio de la expansión: las ligaduras de parámetros
+            // pueden contener llamadas expandibles (max(abs(a), b))
+            it = stmts.erase(it);
+            it = stmts.insert(it, expansion.begin(), expansion.end());
+            delete stmt;
+        } else {
+            ++it;
+        }
+    }
+}
+
+//=== RECORRIDO ===
+void Inliner::run(Program* program) {
+    if (!options.inline_functions || options.inline_limit == 0) return;
+    build_call_graph(program);
+    find_recursive();
+    for (auto decl : program->globalVars) globals.insert(decl->names.begin(), decl->names.end());
+
+    ExpRewriter expand = [&](Exp* e) -> Exp* {
+        auto call = dynamic_cast<FunctionCallExp*>(e);
+        if (!call) return nullptr;
+        for (auto& arg : call->args) arg = rewrite_exp(arg, expand);
+        Exp* inlined = inline_exp(call);
+        if (!inlined) return call;
+        delete call;
+        return inlined;
+    };
+
+    // Orden posterior en el grafo de llamadas: primero las funciones llamadas
+    set<string> done;
+    function<void(const string&)> process = [&](const string& name) {
+        if (!done.insert(name).second) return;
+        for (auto& callee : call_graph[name]) process(callee);
+        current = functions[name];
+        rewrite_block_exps(current->body, expand);
+        inline_block(current->body);
+    };
+    for (auto func : program->functions) process(func->name);
+    current = nullptr;
+}
+
+void Inliner::print_stats(ostream& out) {
+    out << "=== INLINING ===" << endl;
+    for (auto& line : report) out << "  " << line << endl;
+    out << "Llamadas expandidas: " << inlined_exp_count + inlined_stmt_count
+        << " (" << inlined_exp_count << " como expresión, " << inlined_stmt_count << " como bloque)" << endl;
+}
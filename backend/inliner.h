@@ -0,0 +1,60 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include <map>
+#include <set>
+#include <list>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "exp.h"
+#include "options.h"
+
+using namespace std;
+
+// Expansión en línea de funciones pequeñas sobre el AST. Las funciones se procesan
+// de las hojas del grafo de llamadas hacia arriba, así que lo que se copia en cada
+// sitio de llamada ya tiene expandidas sus propias llamadas. Nunca se expanden
+// funciones recursivas (directa o mutuamente) ni main.
+//
+//  - Como expresión: si el cuerpo es solo 'return e', la llamada se reemplaza por e
+//    con los parámetros sustituidos por los argumentos.
+//  - Como bloque: en sentencias 'f(..)', 'x := f(..)', 'x = f(..)' y 'return f(..)'
+//    los argumentos se ligan a los parámetros en un bloque nuevo que contiene el
+//    cuerpo, y cada 'return e' pasa a ser una asignación a un temporal. Solo se
+//    admiten returns en posición final (tras convertir 'if c { return }' en if/else).
+//
+// El costo de una función es su tamaño en nodos del AST; se expande si no supera
+// -finline-limit=N (la mitad para funciones que a su vez llaman a otras). Una
+// función que usa una global no se expande donde una local con ese nombre la tapa.
+class Inliner {
+private:
+    const CompilerOptions& options;
+    map<string, FuncDecl*> functions;
+    set<string> globals;
+    map<string, set<string>> call_graph;
+    set<string> recursive;
+    FuncDecl* current;
+    int temp_counter;
+
+    string new_temp(const string& prefix);
+    void build_call_graph(Program* program);
+    void find_recursive();
+    bool can_inline(FuncDecl* callee);
+    bool shadows_global(FuncDecl* callee);
+    Exp* inline_exp(FunctionCallExp* call);
+    bool inline_stmt(Stmt* stmt, list<Stmt*>& expansion);
+    void inline_block(Block* block);
+    void record(FuncDecl* callee, const string& kind);
+
+public:
+    int inlined_exp_count;
+    int inlined_stmt_count;
+    vector<string> report;
+
+    Inliner(const CompilerOptions& opts);
+    void run(Program* program);
+    void print_stats(ostream& out);
+};
+
+#endif
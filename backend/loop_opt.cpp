@@ -0,0 +1,414 @@
+#include "loop_opt.h"
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <climits>
+#include "ast_utils.h"
+
+using namespace std;
+
+LoopOptimizer::LoopOptimizer(const CompilerOptions& opts)
+    : options(opts), temp_counter(0), hoisted_count(0), reduced_count(0),
+      unrolled_count(0), fully_unrolled_count(0) {}
+
+// Los temporales llevan '$' para que no puedan chocar con identificadores de Go
+string LoopOptimizer::new_temp(const string& prefix) {
+    return prefix + "$" + to_string(temp_counter++);
+}
+
+void LoopOptimizer::run(Program* program) {
+    if (!options.licm && !options.strength_reduce && !options.unroll) return;
+    for (auto decl : program->globalVars) globals.insert(decl->names.begin(), decl->names.end());
+    for (auto func : program->functions) {
+        optimize_block(func->body);
+    }
+}
+
+void LoopOptimizer::optimize_block(Block* block) {
+    if (!block) return;
+    for (auto& stmt : block->statements) {
+        optimize_stmt(stmt);
+    }
+}
+
+void LoopOptimizer::optimize_stmt(Stmt*& stmt) {
+    if (auto loop = dynamic_cast<ForStmt*>(stmt)) {
+        // Primero los bucles internos: lo que ellos saquen a su preheader puede
+        // seguir siendo invariante en el bucle externo.
+        optimize_block(loop->body);
+        Stmt* unrolled = options.unroll ? unroll_loop(loop) : loop;
+        if (unrolled == loop) {
+            stmt = optimize_loop(loop);
+        } else {
+            // El desenrollado deja un bloque con el bucle principal y el de resto
+            for (auto& inner : dynamic_cast<BlockStmt*>(unrolled)->block->statements) {
+                if (auto inner_loop = dynamic_cast<ForStmt*>(inner)) inner = optimize_loop(inner_loop);
+            }
+            stmt = unrolled;
+        }
+    } else if (auto is = dynamic_cast<IfStmt*>(stmt)) {
+        optimize_block(is->thenBlock);
+        optimize_block(is->elseBlock);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(stmt)) {
+        optimize_block(bs->block);
+    }
+}
+
+set<string> LoopOptimizer::call_clobbers(Stmt* s) {
+    set<string> names;
+    collect_called_functions(s, names);
+    return calls_program_function(names) ? globals : set<string>();
+}
+
+Stmt* LoopOptimizer::optimize_loop(ForStmt* loop) {
+    set<string> modified;
+    collect_modified_vars(loop, modified);
+    set<string> clobbered = call_clobbers(loop);
+    modified.insert(clobbered.begin(), clobbered.end());
+
+    list<Stmt*> preheader;
+    if (options.licm) hoist_invariants(loop, modified, preheader);
+    if (options.strength_reduce) reduce_induction_vars(loop, modified, clobbered, preheader);
+
+    if (preheader.empty()) return loop;
+    preheader.push_back(loop);
+    return new BlockStmt(new Block(preheader));
+}
+
+//=== LICM ===
+static bool is_leaf(Exp* e) {
+    return dynamic_cast<NumberExp*>(e) || dynamic_cast<StringExp*>(e) ||
+           dynamic_cast<BoolExp*>(e) || dynamic_cast<IdentifierExp*>(e);
+}
+
+bool LoopOptimizer::is_hoistable(Exp* e, const set<string>& modified) {
+    // Solo vale la pena sacar cálculos, no cargas de una variable o constantes
+    if (is_leaf(e)) return false;
+    if (auto u = dynamic_cast<UnaryExp*>(e)) {
+        if (is_leaf(u->exp)) return false;
+    }
+    // Se puede evaluar aunque el bucle no llegue a ejecutarla
+    if (!is_pure_exp(e) || !cannot_fail(e)) return false;
+
+    set<string> used;
+    collect_used_vars(e, used);
+    for (auto& var : used) {
+        if (modified.count(var)) return false;
+    }
+    return true;
+}
+
+void LoopOptimizer::hoist_invariants(ForStmt* loop, const set<string>& modified, list<Stmt*>& preheader) {
+    map<string, string> hoisted; // expresión canónica -> temporal
+    ExpRewriter hoist = [&](Exp* e) -> Exp* {
+        if (!is_hoistable(e, modified)) return nullptr;
+        string key = exp_key(e);
+        auto it = hoisted.find(key);
+        string name;
+        if (it == hoisted.end()) {
+            name = new_temp("licm");
+            hoisted[key] = name;
+            preheader.push_back(new ShortVarDecl({name}, {e}));
+            hoisted_count++;
+        } else {
+            name = it->second;
+            delete e;
+        }
+        return new IdentifierExp(name);
+    };
+    // El init se ejecuta una sola vez, no hay nada que ganar moviéndolo
+    loop->condition = rewrite_exp(loop->condition, hoist);
+    rewrite_stmt_exps(loop->post, hoist);
+    rewrite_block_exps(loop->body, hoist);
+}
+
+//=== REDUCCIÓN DE FUERZA ===
+// Registra para cada variable las sentencias simples del bucle que la modifican
+static void collect_writers(Stmt* s, map<string, vector<Stmt*>>& writers) {
+    if (!s) return;
+    if (auto is = dynamic_cast<IfStmt*>(s)) {
+        if (is->thenBlock) for (auto st : is->thenBlock->statements) collect_writers(st, writers);
+        if (is->elseBlock) for (auto st : is->elseBlock->statements) collect_writers(st, writers);
+    } else if (auto fs = dynamic_cast<ForStmt*>(s)) {
+        collect_writers(fs->init, writers);
+        collect_writers(fs->post, writers);
+        for (auto st : fs->body->statements) collect_writers(st, writers);
+    } else if (auto bs = dynamic_cast<BlockStmt*>(s)) {
+        for (auto st : bs->block->statements) collect_writers(st, writers);
+    } else {
+        set<string> vars;
+        collect_modified_vars(s, vars);
+        for (auto& v : vars) writers[v].push_back(s);
+    }
+}
+
+// Paso constante de una actualización de variable de inducción (i++, i--, i += c, i -= c)
+static bool induction_step(Stmt* s, const string& var, long long& step) {
+    if (auto id = dynamic_cast<IncDecStmt*>(s)) {
+        step = id->isIncrement ? 1 : -1;
+        return id->variable == var;
+    }
+    if (auto as = dynamic_cast<AssignStmt*>(s)) {
+        auto lhs = dynamic_cast<IdentifierExp*>(as->lhs);
+        auto rhs = dynamic_cast<NumberExp*>(as->rhs);
+        if (!lhs || !rhs || lhs->name != var) return false;
+        // El mínimo no tiene opuesto: i -= c no se podría escribir como un paso
+        if (rhs->value == LLONG_MIN) return false;
+        if (as->op == PLUS_ASSIGN_OP) step = rhs->value;
+        else if (as->op == MINUS_ASSIGN_OP) step = -rhs->value;
+        else return false;
+        return true;
+    }
+    return false;
+}
+
+struct InductionVar {
+    vector<pair<Stmt*, long long>> updates; // sentencia que actualiza la variable y su paso
+};
+
+struct ReducedExp {
+    string iv;
+    string temp;
+    Exp* factor;
+};
+
+void LoopOptimizer::reduce_induction_vars(ForStmt* loop, const set<string>& modified, const set<string>& clobbered,
+                                          list<Stmt*>& preheader) {
+    map<string, vector<Stmt*>> writers;
+    collect_writers(loop->post, writers);
+    for (auto st : loop->body->statements) collect_writers(st, writers);
+
+    // Variables de inducción básicas: todas sus actualizaciones tienen paso constante
+    // y están en el post o en el nivel superior del cuerpo (un bucle desenrollado
+    // tiene una actualización por copia del cuerpo)
+    auto& body = loop->body->statements;
+    map<string, InductionVar> ivs;
+    for (auto& entry : writers) {
+        if (clobbered.count(entry.first)) continue;
+        InductionVar iv;
+        for (auto update : entry.second) {
+            bool top_level = update == loop->post || find(body.begin(), body.end(), update) != body.end();
+            long long step;
+            if (!top_level || !induction_step(update, entry.first, step)) {
+                iv.updates.clear();
+                break;
+            }
+            iv.updates.push_back({update, step});
+        }
+        if (!iv.updates.empty()) ivs[entry.first] = iv;
+    }
+    if (ivs.empty()) return;
+
+    auto invariant_factor = [&](Exp* e) {
+        if (dynamic_cast<NumberExp*>(e)) return true;
+        auto id = dynamic_cast<IdentifierExp*>(e);
+        return id && !modified.count(id->name);
+    };
+
+    map<string, ReducedExp> reduced; // "i*k" -> temporal
+    vector<string> order;
+    ExpRewriter reduce = [&](Exp* e) -> Exp* {
+        auto mul = dynamic_cast<BinaryExp*>(e);
+        if (!mul || mul->op != MUL_OP) return nullptr;
+        IdentifierExp* iv = dynamic_cast<IdentifierExp*>(mul->left);
+        Exp* factor = mul->right;
+        if (!iv || !ivs.count(iv->name) || !invariant_factor(factor)) {
+            iv = dynamic_cast<IdentifierExp*>(mul->right);
+            factor = mul->left;
+            if (!iv || !ivs.count(iv->name) || !invariant_factor(factor)) return nullptr;
+        }
+
+        string key = iv->name + "*" + exp_key(factor);
+        auto it = reduced.find(key);
+        if (it == reduced.end()) {
+            // La inicialización del bucle pasa al preheader para que el temporal
+            // pueda calcularse a partir del valor inicial de la variable
+            if (loop->init) {
+                preheader.push_back(loop->init);
+                loop->init = nullptr;
+            }
+            string temp = new_temp("iv");
+            preheader.push_back(new ShortVarDecl({temp}, {new BinaryExp(new IdentifierExp(iv->name), clone_exp(factor), MUL_OP)}));
+            it = reduced.insert({key, {iv->name, temp, clone_exp(factor)}}).first;
+            order.push_back(key);
+            reduced_count++;
+        }
+        string temp = it->second.temp;
+        delete e;
+        return new IdentifierExp(temp);
+    };
+    loop->condition = rewrite_exp(loop->condition, reduce);
+    rewrite_block_exps(loop->body, reduce);
+
+    for (auto& key : order) {
+        ReducedExp& r = reduced[key];
+        map<long long, string> step_temps;
+        for (auto& update_info : ivs[r.iv].updates) {
+            long long step = update_info.second;
+
+            // temp += paso*k justo después de cada actualización de la variable
+            Exp* increment;
+            AssignOp op = PLUS_ASSIGN_OP;
+            if (auto num = dynamic_cast<NumberExp*>(r.factor)) {
+                // Con desborde circular, como el producto que reemplaza
+                increment = new NumberExp((long long)((unsigned long long)step * num->value));
+            } else if (step == 1 || step == -1) {
+                increment = clone_exp(r.factor);
+                if (step == -1) op = MINUS_ASSIGN_OP;
+            } else {
+                if (!step_temps.count(step)) {
+                    step_temps[step] = new_temp("iv");
+                    preheader.push_back(new ShortVarDecl({step_temps[step]}, {new BinaryExp(new NumberExp(step), clone_exp(r.factor), MUL_OP)}));
+                }
+                increment = new IdentifierExp(step_temps[step]);
+            }
+            Stmt* update = new AssignStmt(new IdentifierExp(r.temp), increment, op);
+
+            if (update_info.first == loop->post) {
+                // Como no hay continue, el final del cuerpo siempre precede al post
+                body.push_back(update);
+            } else {
+                auto pos = find(body.begin(), body.end(), update_info.first);
+                body.insert(next(pos), update);
+            }
+        }
+        delete r.factor;
+    }
+}
+
+//=== DESENROLLADO ===
+// Bucle contado: for [init]; i OP limite; i += paso { cuerpo que no escribe i ni el límite }
+struct CountedLoop {
+    string var;
+    BinaryOp cmp;
+    Exp* limit;
+    long long step;
+};
+
+static bool match_counted_loop(ForStmt* loop, CountedLoop& info) {
+    auto cond = dynamic_cast<BinaryExp*>(loop->condition);
+    if (!cond || !loop->post) return false;
+    auto iv = dynamic_cast<IdentifierExp*>(cond->left);
+    if (!iv) return false;
+    bool upward = cond->op == LT_OP || cond->op == LE_OP;
+    bool downward = cond->op == GT_OP || cond->op == GE_OP;
+    long long step;
+    if (!(upward || downward) || !induction_step(loop->post, iv->name, step)) return false;
+    if (step == 0 || (step > 0) != upward) return false;
+
+    set<string> modified;
+    collect_modified_vars(loop->body, modified);
+    if (modified.count(iv->name) || !is_pure_exp(cond->right)) return false;
+    set<string> used;
+    collect_used_vars(cond->right, used);
+    for (auto& var : used) {
+        if (var == iv->name || modified.count(var)) return false;
+    }
+
+    // Solo se desenrollan los bucles más internos
+    for (auto st : loop->body->statements) {
+        if (dynamic_cast<ForStmt*>(st)) return false;
+    }
+    info = {iv->name, cond->op, cond->right, step};
+    return true;
+}
+
+// Valor inicial constante de la variable del bucle, si el init lo fija
+static bool constant_start(ForStmt* loop, const string& var, long long& start) {
+    if (auto sv = dynamic_cast<ShortVarDecl*>(loop->init)) {
+        if (sv->identifiers.size() != 1 || sv->identifiers.front() != var) return false;
+        auto num = dynamic_cast<NumberExp*>(sv->values.front());
+        if (!num) return false;
+        start = num->value;
+        return true;
+    }
+    if (auto as = dynamic_cast<AssignStmt*>(loop->init)) {
+        auto lhs = dynamic_cast<IdentifierExp*>(as->lhs);
+        auto num = dynamic_cast<NumberExp*>(as->rhs);
+        if (!lhs || !num || lhs->name != var || as->op != ASSIGN_OP) return false;
+        start = num->value;
+        return true;
+    }
+    return false;
+}
+
+static long long trip_count(long long start, long long limit, long long step, BinaryOp cmp) {
+    long long distance = step > 0 ? limit - start : start - limit;
+    long long stride = step > 0 ? step : -step;
+    if (cmp == LE_OP || cmp == GE_OP) distance++;
+    if (distance <= 0) return 0;
+    return 1 + (distance - 1) / stride;
+}
+
+Stmt* LoopOptimizer::unroll_loop(ForStmt* loop) {
+    CountedLoop info;
+    if (!match_counted_loop(loop, info)) return loop;
+    // Una llamada del cuerpo podría mover la variable o el límite si son globales
+    set<string> clobbered = call_clobbers(loop);
+    set<string> used = {info.var};
+    collect_used_vars(info.limit, used);
+    for (auto& var : used) {
+        if (clobbered.count(var)) return loop;
+    }
+
+    int body_size = count_nodes(loop->body) + count_nodes(loop->post);
+    if (body_size == 0) body_size = 1;
+
+    list<Stmt*> stmts;
+    long long start;
+    auto limit = dynamic_cast<NumberExp*>(info.limit);
+    if (limit && constant_start(loop, info.var, start) && start >= INT32_MIN && start <= INT32_MAX &&
+        limit->value >= INT32_MIN && limit->value <= INT32_MAX) {
+        long long trips = trip_count(start, limit->value, info.step, info.cmp);
+        if (trips <= options.unroll_full_max && trips * body_size <= options.unroll_budget) {
+            // Desenrollado completo: init; {cuerpo}; post; {cuerpo}; post; ...
+            stmts.push_back(loop->init);
+            for (long long t = 0; t < trips; t++) {
+                stmts.push_back(new BlockStmt(clone_block(loop->body)));
+                stmts.push_back(clone_stmt(loop->post));
+            }
+            loop->init = nullptr;
+            delete loop;
+            fully_unrolled_count++;
+            return new BlockStmt(new Block(stmts));
+        }
+    }
+
+    int factor = options.unroll_factor;
+    if (factor * body_size > options.unroll_budget) factor = options.unroll_budget / body_size;
+    if (factor < 2) return loop;
+
+    // Bucle principal: mientras queden al menos 'factor' iteraciones ejecuta
+    // 'factor' copias del cuerpo seguidas, sin volver a comprobar la condición. La
+    // guarda es i OP limite - (factor-1)*paso: i + (factor-1)*paso podría desbordarse
+    // con i cerca del extremo, y la resta solo se desborda si el límite lo está, lo
+    // que se descarta antes de entrar (o al compilar, si el límite es constante)
+    long long delta;
+    if (__builtin_mul_overflow((long long)(factor - 1), info.step, &delta)) return loop;
+    long long bound = delta > 0 ? LLONG_MIN + delta : LLONG_MAX + delta;
+    Exp* in_range = nullptr;
+    if (limit) {
+        if (delta > 0 ? limit->value < bound : limit->value > bound) return loop;
+    } else {
+        in_range = new BinaryExp(clone_exp(info.limit), new NumberExp(bound), delta > 0 ? GE_OP : LE_OP);
+    }
+    Exp* shifted = limit ? (Exp*)new NumberExp(limit->value - delta)
+                         : new BinaryExp(clone_exp(info.limit), new NumberExp(delta), MINUS_OP);
+    Exp* guard = new BinaryExp(new IdentifierExp(info.var), shifted, info.cmp);
+    list<Stmt*> unrolled_body;
+    for (int copy = 0; copy < factor; copy++) {
+        // Cada copia va en su propio bloque para conservar el alcance de sus variables
+        unrolled_body.push_back(new BlockStmt(clone_block(loop->body)));
+        unrolled_body.push_back(clone_stmt(loop->post));
+    }
+    if (loop->init) stmts.push_back(loop->init);
+    loop->init = nullptr;
+    Stmt* unrolled = new ForStmt(nullptr, guard, nullptr, new Block(unrolled_body));
+    if (in_range) unrolled = new IfStmt(in_range, new Block({unrolled}));
+    stmts.push_back(unrolled);
+    // Bucle de resto: el original sin init, para las iteraciones sobrantes
+    stmts.push_back(loop);
+    unrolled_count++;
+    return new BlockStmt(new Block(stmts));
+}
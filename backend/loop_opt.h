@@ -0,0 +1,55 @@
+#ifndef LOOP_OPT_H
+#define LOOP_OPT_H
+
+#include <set>
+#include <list>
+#include <string>
+#include "exp.h"
+#include "options.h"
+
+using namespace std;
+
+// Optimizaciones de bucles sobre el AST. Como el lenguaje no tiene goto, break ni
+// continue, cada ForStmt es un bucle natural con una única entrada; el preheader es
+// un bloque nuevo que envuelve al bucle y se ejecuta una sola vez antes de entrar.
+//
+//  - LICM: las subexpresiones puras cuyo valor no cambia dentro del bucle
+//    (len(s), n*2, p.campo, ...) se calculan una vez en el preheader.
+//  - Reducción de fuerza: para una variable de inducción i (que solo cambia con
+//    i++, i-- o i += c) las expresiones i*k con k invariante se reemplazan por una
+//    variable que se actualiza sumando c*k cada vez que cambia i.
+//  - Desenrollado: los bucles contados (for i := a; i < N; i++ con N invariante)
+//    se desenrollan por completo si tienen pocas iteraciones constantes, o se
+//    replican 'unroll_factor' veces con un bucle de resto para las sobrantes.
+//
+// Una llamada a una función del programa dentro del bucle puede escribir cualquier
+// global, así que en ese bucle las globales cuentan como modificadas.
+class LoopOptimizer {
+private:
+    const CompilerOptions& options;
+    int temp_counter;
+    set<string> globals;
+
+    string new_temp(const string& prefix);
+    void optimize_block(Block* block);
+    void optimize_stmt(Stmt*& stmt);
+    Stmt* optimize_loop(ForStmt* loop);
+    Stmt* unroll_loop(ForStmt* loop);
+    // Globales que la sentencia puede escribir a través de una llamada
+    set<string> call_clobbers(Stmt* s);
+    void hoist_invariants(ForStmt* loop, const set<string>& modified, list<Stmt*>& preheader);
+    void reduce_induction_vars(ForStmt* loop, const set<string>& modified, const set<string>& clobbered,
+                               list<Stmt*>& preheader);
+    bool is_hoistable(Exp* e, const set<string>& modified);
+
+public:
+    int hoisted_count;
+    int reduced_count;
+    int unrolled_count;
+    int fully_unrolled_count;
+
+    LoopOptimizer(const CompilerOptions& opts);
+    void run(Program* program);
+};
+
+#endif
@@ -1,24 +1,119 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <sstream>
 #include "scanner.h"
 #include "parser.h"
 #include "visitor.h"
 #include "gencode.h"
+#include "options.h"
+#include "loop_opt.h"
+#include "inliner.h"
+#include "dce.h"
+#include "fold.h"
 
 using namespace std;
 
+// Fase 4: pasadas de optimización sobre el AST, en orden
+static void optimize(Program* program, const CompilerOptions& options) {
+    ConstantFolder folder(options);
+    folder.check_divisions(program);
+
+    Inliner inliner(options);
+    inliner.run(program);
+    if (options.inline_stats) inliner.print_stats(cerr);
+
+    folder.run(program);
+
+    DeadCodeEliminator dce(options);
+    dce.run(program);
+    if (options.size_report) dce.print_stats(cerr);
+
+    LoopOptimizer loop_optimizer(options);
+    loop_optimizer.run(program);
+}
+
+// Tamaño del ensamblador generado: bytes de texto e instrucciones (líneas
+// indentadas que no son comentarios)
+static void measure_assembly(const string& assembly, size_t& bytes, int& instructions) {
+    bytes = assembly.size();
+    instructions = 0;
+    istringstream lines(assembly);
+    string line;
+    while (getline(lines, line)) {
+        if (line.size() > 2 && line[0] == ' ' && line[2] != '#') instructions++;
+    }
+}
+
+// Compila de nuevo el programa sin eliminación de código muerto para comparar
+static void report_size(const string& input, const CompilerOptions& options, const string& assembly) {
+    CompilerOptions baseline = options;
+    baseline.dce = false;
+    baseline.inline_stats = false;
+    baseline.size_report = false;
+    baseline.frame_report = false;
+    baseline.escape_report = false;
+
+    Scanner scanner(input.c_str());
+    GoParser parser(&scanner);
+    Program* program = parser.parse();
+    if (!program) return;
+    optimize(program, baseline);
+    ostringstream baseline_out;
+    GoCodeGen codeGen(baseline_out, baseline);
+    codeGen.generateCode(program);
+    delete program;
+
+    size_t before_bytes, after_bytes;
+    int before_instrs, after_instrs;
+    measure_assembly(baseline_out.str(), before_bytes, before_instrs);
+    measure_assembly(assembly, after_bytes, after_instrs);
+    cerr << "=== TAMAÑO ===" << endl;
+    cerr << "Sin eliminación de código muerto: " << before_bytes << " bytes, " << before_instrs << " instrucciones" << endl;
+    cerr << "Con eliminación de código muerto: " << after_bytes << " bytes, " << after_instrs << " instrucciones" << endl;
+    cerr << "Ahorro: " << (long)before_bytes - (long)after_bytes << " bytes, "
+         << before_instrs - after_instrs << " instrucciones" << endl;
+}
+
 int main(int argc, const char* argv[]) {
-    if (argc < 2 || argc > 3) {
-        cout << "Uso: " << argv[0] << " <archivo_go> [-s para solo ensamblador]" << endl;
-        exit(1);
+    string input_path;
+    bool assembly_only = false;
+    CompilerOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-s") {
+            assembly_only = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            if (!options.parse(arg)) {
+                cout << "Opción desconocida: " << arg << endl;
+                exit(1);
+            }
+        } else if (input_path.empty()) {
+            input_path = arg;
+        } else {
+            input_path.clear();
+            break;
+        }
     }
 
-    bool assembly_only = (argc == 3 && string(argv[2]) == "-s");
+    if (input_path.empty()) {
+        cout << "Uso: " << argv[0] << " <archivo_go> [-s para solo ensamblador] [opciones]" << endl;
+        cout << "Opciones: -O0 -fno-licm -fno-strength-reduce -fno-unroll -fno-tail-calls -fno-inline -fno-fold -fno-dce" << endl;
+        cout << "          -fno-const-eval -fconst-eval-steps=N -fconst-eval-depth=N -fconst-eval-bytes=N" << endl;
+        cout << "          -fno-omit-frame-pointer -fframe-report -fno-struct-reorder" << endl;
+        cout << "          -fno-struct-block-ops -fstruct-rep-threshold=N -fno-string-builder" << endl;
+        cout << "          -fno-buffered-output -fno-arena -falloc-stats" << endl;
+        cout << "          -fno-gc -fgc-heap-min=N" << endl;
+        cout << "          -fno-escape-analysis -fstack-buffer=N -fescape-report" << endl;
+        cout << "          -funroll-factor=N -funroll-full-max=N -funroll-budget=N" << endl;
+        cout << "          -finline-limit=N -finline-stats -fsize-report" << endl;
+        exit(1);
+    }
 
-    ifstream infile(argv[1]);
+    ifstream infile(input_path);
     if (!infile.is_open()) {
-        cout << "No se pudo abrir el archivo: " << argv[1] << endl;
+        cout << "No se pudo abrir el archivo: " << input_path << endl;
         exit(1);
     }
 
@@ -31,7 +126,7 @@ int main(int argc, const char* argv[]) {
 
     if (!assembly_only) {
         cout << "=== COMPILADOR GO ===" << endl;
-        cout << "Archivo: " << argv[1] << endl;
+        cout << "Archivo: " << input_path << endl;
         cout << "Contenido:" << endl;
         cout << input << endl;
         cout << "===================" << endl << endl;
@@ -63,13 +158,26 @@ int main(int argc, const char* argv[]) {
             PrintVisitor printVisitor;
             printVisitor.print(program);
             cout << endl;
-            
-            // Fase 4: Generar código ensamblador
+        }
+
+        // Fase 4: Optimizaciones sobre el AST
+        optimize(program, options);
+
+        // Fase 5: Generar código ensamblador
+        if (!assembly_only) {
             cout << "=== CODIGO ENSAMBLADOR ===" << endl;
         }
         
-        GoCodeGen codeGen;
-        codeGen.generateCode(program);
+        if (options.size_report) {
+            ostringstream assembly;
+            GoCodeGen codeGen(assembly, options);
+            codeGen.generateCode(program);
+            cout << assembly.str();
+            report_size(input, options, assembly.str());
+        } else {
+            GoCodeGen codeGen(cout, options);
+            codeGen.generateCode(program);
+        }
         
         // Clean up
         delete program;
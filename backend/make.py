@@ -17,7 +17,9 @@ outputs_dir = "outputs"
 source_files = [
     "main.cpp", "scanner.cpp", "token.cpp", 
     "parser.cpp", "exp.cpp", "visitor.cpp", 
-    "gencode.cpp", "imp_value.cpp", "helpers_gencode.cpp"
+    "gencode.cpp", "imp_value.cpp", "helpers_gencode.cpp",
+    "ast_utils.cpp", "loop_opt.cpp", "inliner.cpp", "dce.cpp",
+    "escape.cpp", "fold.cpp", "evaluator.cpp"
 ]
 
 if system == "Windows":
@@ -0,0 +1,143 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <string>
+
+using namespace std;
+
+// Opciones de línea de comandos que controlan las pasadas de optimización.
+// Todas las optimizaciones están activas por defecto; -O0 las desactiva.
+struct CompilerOptions {
+    bool licm = true;            // Movimiento de código invariante fuera de los bucles
+    bool strength_reduce = true; // Reducción de fuerza de variables de inducción
+    bool unroll = true;          // Desenrollado de bucles contados
+    int unroll_factor = 4;       // Copias del cuerpo por iteración del bucle desenrollado
+    int unroll_full_max = 16;    // Máximo de iteraciones para desenrollar por completo
+    int unroll_budget = 256;     // Máximo de nodos del AST que puede ocupar el cuerpo desenrollado
+    bool tail_calls = true;      // return f(...) como salto; la recursión de cola se vuelve un bucle
+    bool inline_functions = true; // Expansión en línea de funciones pequeñas
+    int inline_limit = 40;       // Costo máximo (nodos del AST) de una función a expandir
+    bool inline_stats = false;   // Reporta en stderr las llamadas expandidas
+    bool omit_frame_pointer = true; // Funciones hoja sin marco, con locales en la red zone
+    bool frame_report = false;   // Reporta en stderr el tamaño del marco de cada función
+    bool struct_reorder = true;  // Reordena campos de structs para minimizar el relleno
+    bool struct_block_ops = true; // Copia y puesta a cero de structs con SSE2 / rep
+    int struct_rep_threshold = 1024; // Bytes desde los que se usa rep stosq/movsq
+    bool fold = true;            // Plegado y propagación de constantes
+    bool const_eval = true;      // Llamadas a funciones puras con argumentos constantes
+    int const_eval_steps = 100000; // Sentencias y expresiones que puede ejecutar cada una
+    int const_eval_depth = 200;  // Llamadas anidadas que puede hacer cada una
+    int const_eval_bytes = 65536; // Largo de cada string y bytes de todos los resultados memorizados
+    bool dce = true;             // Eliminación de funciones y código inalcanzables
+    bool size_report = false;    // Reporta en stderr el tamaño ahorrado por la eliminación
+    bool string_builder = true;  // s += e en bucles crece en su lugar con capacidad geométrica
+    bool buffered_output = true; // fmt.Println escribe a un buffer propio en lugar de usar printf
+    bool arena_alloc = true;     // Reservas del runtime desde chunks propios en lugar de malloc
+    bool alloc_stats = false;    // Al terminar main, reporta en stderr las reservas del runtime
+    bool gc = true;              // Recolector mark-sweep sobre el reservador propio
+    int gc_heap_min = 4 << 20;   // Bytes vivos desde los que se recolecta por primera vez
+    bool escape_analysis = true; // Concatenaciones que no escapan van a buffers del marco
+    int stack_buffer = 128;      // Bytes de cada uno de esos buffers (múltiplo de 16)
+    bool escape_report = false;  // Reporta en stderr el resultado del análisis de escape
+
+    // Interpreta una opción; devuelve false si no la reconoce
+    bool parse(const string& arg) {
+        int value;
+        if (arg == "-O0") {
+            licm = false;
+            strength_reduce = false;
+            unroll = false;
+            tail_calls = false;
+            inline_functions = false;
+            fold = false;
+            const_eval = false;
+            dce = false;
+            omit_frame_pointer = false;
+            struct_reorder = false;
+            struct_block_ops = false;
+            string_builder = false;
+            buffered_output = false;
+            arena_alloc = false;
+            escape_analysis = false;
+        } else if (arg == "-fno-licm") {
+            licm = false;
+        } else if (arg == "-fno-strength-reduce") {
+            strength_reduce = false;
+        } else if (arg == "-fno-unroll") {
+            unroll = false;
+        } else if (arg == "-fno-tail-calls") {
+            tail_calls = false;
+        } else if (arg == "-fno-inline") {
+            inline_functions = false;
+        } else if (arg == "-fno-omit-frame-pointer") {
+            omit_frame_pointer = false;
+        } else if (arg == "-fframe-report") {
+            frame_report = true;
+        } else if (arg == "-fno-struct-reorder") {
+            struct_reorder = false;
+        } else if (arg == "-fno-struct-block-ops") {
+            struct_block_ops = false;
+        } else if (arg == "-fno-string-builder") {
+            string_builder = false;
+        } else if (arg == "-fno-buffered-output") {
+            buffered_output = false;
+        } else if (arg == "-fno-arena") {
+            arena_alloc = false;
+        } else if (arg == "-fno-gc") {
+            gc = false;
+        } else if (arg == "-fno-escape-analysis") {
+            escape_analysis = false;
+        } else if (arg == "-fescape-report") {
+            escape_report = true;
+        } else if (arg == "-falloc-stats") {
+            alloc_stats = true;
+        } else if (arg == "-fno-fold") {
+            fold = false;
+        } else if (arg == "-fno-const-eval") {
+            const_eval = false;
+        } else if (arg == "-fno-dce") {
+            dce = false;
+        } else if (arg == "-fsize-report") {
+            size_report = true;
+        } else if (arg == "-finline-stats") {
+            inline_stats = true;
+        } else if (parse_int(arg, "-finline-limit=", value)) {
+            inline_limit = value;
+        } else if (parse_int(arg, "-funroll-factor=", value)) {
+            unroll_factor = value;
+        } else if (parse_int(arg, "-funroll-full-max=", value)) {
+            unroll_full_max = value;
+        } else if (parse_int(arg, "-funroll-budget=", value)) {
+            unroll_budget = value;
+        } else if (parse_int(arg, "-fconst-eval-steps=", value)) {
+            const_eval_steps = value;
+        } else if (parse_int(arg, "-fconst-eval-depth=", value)) {
+            const_eval_depth = value;
+        } else if (parse_int(arg, "-fconst-eval-bytes=", value)) {
+            const_eval_bytes = value;
+        } else if (parse_int(arg, "-fgc-heap-min=", value)) {
+            gc_heap_min = value;
+        } else if (parse_int(arg, "-fstack-buffer=", value)) {
+            stack_buffer = (value + 15) & -16;
+        } else if (parse_int(arg, "-fstruct-rep-threshold=", value)) {
+            struct_rep_threshold = value;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // Opciones con valor numérico: -fnombre=N
+    static bool parse_int(const string& arg, const string& prefix, int& value) {
+        if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+        try {
+            value = stoi(arg.substr(prefix.size()));
+        } catch (...) {
+            return false;
+        }
+        return value >= 0;
+    }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "parser.h"
+#include "ast_utils.h"
 #include <iostream>
 #include <stdexcept>
 #include <cctype>
@@ -269,9 +270,12 @@ StructType* GoParser::parseStructType() {
         // Ahora debemos tener el tipo del campo
         Type* fieldType = parseType();
         
-        // Agregamos todos los campos con este tipo
+        // Agregamos todos los campos con este tipo (cada uno con su copia, porque
+        // el AST es dueño de sus nodos)
+        bool first = true;
         for (const string& name : fieldNames) {
-            fields.push_back(make_pair(name, fieldType));
+            fields.push_back(make_pair(name, first ? fieldType : clone_type(fieldType)));
+            first = false;
         }
     }
     
@@ -306,9 +310,11 @@ list<pair<string, Type*>> GoParser::parseParamList() {
             // Ahora debemos tener el tipo del parámetro
             Type* paramType = parseType();
             
-            // Agregamos todos los parámetros con este tipo
+            // Agregamos todos los parámetros con este tipo (cada uno con su copia)
+            bool first = true;
             for (const string& name : paramNames) {
-                params.push_back(make_pair(name, paramType));
+                params.push_back(make_pair(name, first ? paramType : clone_type(paramType)));
+                first = false;
             }
             
             // Chequeamos si hay más parámetros
@@ -361,8 +367,7 @@ Stmt* GoParser::parseStmt() {
     } else if (check(Token::RETURN)) {
         return parseReturnStmt();
     } else if (check(Token::LBRACE)) {
-        Block* block = parseBlock();
-        return new ExprStmt(new NumberExp(0)); // Placeholder
+        return new BlockStmt(parseBlock());
     } else {
         return parseSimpleStmt();
     }
@@ -435,6 +440,20 @@ Stmt* GoParser::parseSimpleStmt() {
             // Esto es un hack la verdad necesita hacerse refactorización
             // para que las expresiones sean más robustas y no dependan de un solo identificador
             Exp* expr = parseExpressionFromIdentifier(identifiers.front());
+
+            // Asignación a un campo: p.x = e, a.b.c += e
+            if (dynamic_cast<FieldAccessExp*>(expr)) {
+                AssignOp op;
+                bool is_assign = true;
+                if (match(Token::ASSIGN)) op = ASSIGN_OP;
+                else if (match(Token::PLUS_ASSIGN)) op = PLUS_ASSIGN_OP;
+                else if (match(Token::MINUS_ASSIGN)) op = MINUS_ASSIGN_OP;
+                else if (match(Token::MUL_ASSIGN)) op = MUL_ASSIGN_OP;
+                else if (match(Token::DIV_ASSIGN)) op = DIV_ASSIGN_OP;
+                else if (match(Token::MOD_ASSIGN)) op = MOD_ASSIGN_OP;
+                else is_assign = false;
+                if (is_assign) return new AssignStmt(expr, parseExpression(), op);
+            }
             return new ExprStmt(expr);
         }
     } else {
@@ -667,7 +686,7 @@ Exp* GoParser::parsePrimaryExpr() {
     Exp* expr = nullptr;
     
     if (match(Token::NUM)) {
-        int value = stoi(previous->text);
+        long long value = stoll(previous->text);
         expr = new NumberExp(value);
     } else if (match(Token::STRING_LIT)) {
         string value = previous->text;
@@ -690,11 +709,12 @@ Exp* GoParser::parsePrimaryExpr() {
         } else if (!name.empty() && isupper(name[0]) && match(Token::LBRACE)) {
             // Literal de estructura
             // Asumimos que es un literal de estructura si el nombre empieza con mayúscula
-            list<Exp*> values = parseStructLiteralValues();
+            list<string> fields;
+            list<Exp*> values = parseStructLiteralValues(fields);
             if (!match(Token::RBRACE)) {
                 error("Expected '}' after struct literal");
             }
-            expr = new StructLiteralExp(name, values);
+            expr = new StructLiteralExp(name, values, fields);
         } else {
             // Identificador simple
             expr = new IdentifierExp(name);
@@ -720,7 +740,8 @@ Exp* GoParser::parsePrimaryExpr() {
             advance();
             expr = new FieldAccessExp(expr, fieldName);
         } else if (match(Token::LBRACKET)) {
-            Exp* index = parseExpression();
+            // En s[:b] falta el inicio
+            Exp* index = check(Token::COLON) ? nullptr : parseExpression();
             
             // Chequeamos si es una expresión de slice [start:end]
             if (match(Token::COLON)) {
@@ -735,6 +756,7 @@ Exp* GoParser::parsePrimaryExpr() {
                 expr = new SliceExp(expr, index, end);
             } else {
                 // Indexación regular
+                if (!index) error("Expected index expression");
                 if (!match(Token::RBRACKET)) {
                     error("Expected ']' after array index");
                 }
@@ -814,7 +836,8 @@ Exp* GoParser::parseExpressionFromIdentifier(const string& identifierName) {
             advance();
             expr = new FieldAccessExp(expr, fieldName);
         } else if (match(Token::LBRACKET)) {
-            Exp* index = parseExpression();
+            // En s[:b] falta el inicio
+            Exp* index = check(Token::COLON) ? nullptr : parseExpression();
             
             // Chequeamos si es una expresión de slice [start:end]
             if (match(Token::COLON)) {
@@ -829,6 +852,7 @@ Exp* GoParser::parseExpressionFromIdentifier(const string& identifierName) {
                 expr = new SliceExp(expr, index, end);
             } else {
                 // Indexación regular
+                if (!index) error("Expected index expression");
                 if (!match(Token::RBRACKET)) {
                     error("Expected ']' after array index");
                 }
@@ -890,8 +914,9 @@ Exp* GoParser::parseExpressionFromIdentifier(const string& identifierName) {
     return expr;
 }
 
-// Parsea los valores de un literal de estructura
-list<Exp*> GoParser::parseStructLiteralValues() {
+// Parsea los valores de un literal de estructura; en uno con claves deja en 'fields'
+// el campo de cada valor
+list<Exp*> GoParser::parseStructLiteralValues(list<string>& fields) {
     list<Exp*> values;
     
     if (!check(Token::RBRACE) && !isAtEnd()) {
@@ -902,6 +927,7 @@ list<Exp*> GoParser::parseStructLiteralValues() {
             
             if (match(Token::COLON)) {
                 // Esto es un campo nombrado
+                fields.push_back(firstId);
                 Exp* firstValue = parseExpression();
                 values.push_back(firstValue);
                 
@@ -910,6 +936,7 @@ list<Exp*> GoParser::parseStructLiteralValues() {
                     if (!check(Token::ID)) {
                         error("Expected field name");
                     }
+                    fields.push_back(current->text);
                     advance(); // Avanzamos al siguiente ID
                     
                     if (!match(Token::COLON)) {
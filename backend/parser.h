@@ -66,7 +66,7 @@ private:
     list<string> parseIdentifierList();
     
     // Struct literal parsing
-    list<Exp*> parseStructLiteralValues();
+    list<Exp*> parseStructLiteralValues(list<string>& fields);
     
     // Literals
     StructLiteralExp* parseStructLiteral(const string& typeName);
@@ -0,0 +1,34 @@
+package main
+
+import "fmt"
+
+type Punto struct {
+	x int
+	y int
+}
+
+func suma8(a int, b int, c int, d int, e int, f int, g int, h int) int {
+	return a*1 + b*2 + c*3 + d*4 + e*5 + f*6 + g*7 + h*8
+}
+
+func resta(a int, b int) int {
+	return a - b
+}
+
+func saludo(nombre string, veces int) string {
+	s := ""
+	for i := 0; i < veces; i++ {
+		s += nombre
+	}
+	return s
+}
+
+func main() {
+	p := Punto{3, 4}
+	k := 10
+	fmt.Println(suma8(1, 2, 3, 4, 5, 6, 7, 8))
+	fmt.Println(suma8(resta(k, 1), k, resta(20, k), p.x, p.y, k/3, resta(k, 4), 1))
+	fmt.Println(resta(resta(k, 2), resta(5, 1)))
+	fmt.Println(saludo("ab", 3))
+	fmt.Println(len(saludo("xyz", resta(k, 6))))
+}
@@ -0,0 +1,38 @@
+package main
+
+import "fmt"
+
+func sumaHasta(n int, acc int) int {
+	if n == 0 {
+		return acc
+	}
+	return sumaHasta(n-1, acc+n)
+}
+
+func esPar(n int) bool {
+	if n == 0 {
+		return true
+	}
+	return esImpar(n - 1)
+}
+
+func esImpar(n int) bool {
+	if n == 0 {
+		return false
+	}
+	return esPar(n - 1)
+}
+
+func mcd(a int, b int) int {
+	if b == 0 {
+		return a
+	}
+	return mcd(b, a%b)
+}
+
+func main() {
+	fmt.Println(sumaHasta(10000000, 0))
+	fmt.Println(esPar(10000000))
+	fmt.Println(esImpar(7))
+	fmt.Println(mcd(1071, 462))
+}
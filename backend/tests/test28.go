@@ -0,0 +1,77 @@
+package main
+
+import "fmt"
+
+func max(a int, b int) int {
+	if a > b {
+		return a
+	}
+	return b
+}
+
+func abs(x int) int {
+	if x < 0 {
+		return -x
+	}
+	return x
+}
+
+func cuadrado(x int) int {
+	return x * x
+}
+
+func sumaCuad(a int, b int) int {
+	return cuadrado(a) + cuadrado(b)
+}
+
+func efecto(n int) int {
+	fmt.Println(n)
+	return n
+}
+
+func resta(a int, b int) int {
+	return a - b
+}
+
+func saluda(s string) {
+	fmt.Println("hola " + s)
+}
+
+func clasifica(n int) string {
+	if n < 0 {
+		return "neg"
+	} else if n == 0 {
+		return "cero"
+	}
+	s := "pos"
+	if n > 100 {
+		s = "grande"
+	}
+	return s
+}
+
+func main() {
+	a := 3
+	b := -7
+	fmt.Println(max(a, b))
+	fmt.Println(abs(b) + abs(a))
+	x := max(abs(b), cuadrado(a))
+	fmt.Println(x)
+	fmt.Println(sumaCuad(a+1, b))
+	fmt.Println(resta(efecto(10), efecto(4)))
+	fmt.Println(cuadrado(efecto(5)))
+	saluda("mundo")
+	fmt.Println(clasifica(b))
+	fmt.Println(clasifica(0))
+	fmt.Println(clasifica(500))
+	c := clasifica(5)
+	fmt.Println(c)
+	total := 0
+	for i := 0; i < 10; i++ {
+		total += max(i, 5)
+	}
+	fmt.Println(total)
+	y := 2
+	x = max(y, x)
+	fmt.Println(x)
+}
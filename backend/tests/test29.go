@@ -0,0 +1,45 @@
+package main
+
+import "fmt"
+
+func nunca(x int) int {
+	return x * 2
+}
+
+func soloDesdeMuerto(x int) int {
+	for i := 0; i < x; i++ {
+		x = x - 1
+	}
+	return x
+}
+
+func muerta() int {
+	return soloDesdeMuerto(3)
+}
+
+func signo(x int) int {
+	if x < 0 {
+		return -1
+	} else {
+		return 1
+	}
+	fmt.Println("inalcanzable")
+	return 0
+}
+
+func main() {
+	debug := false
+	if false {
+		fmt.Println(muerta())
+	}
+	if !false {
+		fmt.Println("activo")
+	} else {
+		fmt.Println("nunca")
+	}
+	for false {
+		fmt.Println("nunca")
+	}
+	fmt.Println(signo(-4))
+	fmt.Println(debug)
+}
@@ -0,0 +1,42 @@
+package main
+
+import "fmt"
+
+func ramas(n int) int {
+	r := 0
+	if n > 10 {
+		a := n * 2
+		b := a + 1
+		c := b * b
+		r = c - a
+	} else {
+		x := n + 7
+		y := x * 3
+		r = y
+	}
+	{
+		p := r + 1
+		q := p * 2
+		r = q
+	}
+	for i := 0; i < 3; i++ {
+		t := i * r
+		u := t + 1
+		r = r + u
+	}
+	s := "fin"
+	fmt.Println(s)
+	return r
+}
+
+func main() {
+	fmt.Println(ramas(4))
+	fmt.Println(ramas(20))
+	z := 5
+	if z > 2 {
+		w := z * 10
+		fmt.Println(w)
+	}
+	v := 9
+	fmt.Println(v + z)
+}
@@ -0,0 +1,59 @@
+package main
+
+import "fmt"
+
+type Punto struct {
+	x int
+	y int
+}
+
+type Celda struct {
+	activa bool
+	valor int
+	visible bool
+	peso int
+	nombre string
+}
+
+type Segmento struct {
+	cerrado bool
+	a Punto
+	b Punto
+}
+
+func main() {
+	c := Celda{true, 42, false, 7, "celda"}
+	fmt.Println(c.activa)
+	fmt.Println(c.valor)
+	fmt.Println(c.visible)
+	fmt.Println(c.peso)
+	fmt.Println(c.nombre)
+
+	c.visible = !c.activa
+	c.valor += c.peso
+	fmt.Println(c.visible)
+	fmt.Println(c.valor)
+
+	var vacia Celda
+	fmt.Println(vacia.activa)
+	fmt.Println(vacia.valor)
+	vacia.activa = true
+	fmt.Println(vacia.activa)
+
+	s := Segmento{true, Punto{1, 2}, Punto{10, 20}}
+	fmt.Println(s.a.x + s.b.x)
+	fmt.Println(s.a.y * s.b.y)
+	s.b.y = 5
+	s.a.x -= 3
+	fmt.Println(s.b.y)
+	fmt.Println(s.a.x)
+	if s.cerrado {
+		fmt.Println("cerrado")
+	}
+
+	parcial := Celda{activa: false, valor: 9}
+	fmt.Println(parcial.valor)
+	fmt.Println(parcial.peso)
+	otra := Celda{peso: 3, nombre: "otra", activa: true}
+	fmt.Println(otra.activa, otra.valor, otra.visible, otra.peso, otra.nombre)
+}
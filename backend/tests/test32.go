@@ -0,0 +1,211 @@
+package main
+
+import "fmt"
+
+type Punto struct {
+	x int
+	y int
+}
+
+type Marca struct {
+	activa bool
+	visible bool
+	fija bool
+}
+
+type Caja struct {
+	nombre string
+	esquina Punto
+	tam Punto
+	marca Marca
+}
+
+type Grande struct {
+	c0 int
+	c1 int
+	c2 int
+	c3 int
+	c4 int
+	c5 int
+	c6 int
+	c7 int
+	c8 int
+	c9 int
+	c10 int
+	c11 int
+	c12 int
+	c13 int
+	c14 int
+	c15 int
+	c16 int
+	c17 int
+	c18 int
+	c19 int
+	c20 int
+	c21 int
+	c22 int
+	c23 int
+	c24 int
+	c25 int
+	c26 int
+	c27 int
+	c28 int
+	c29 int
+	c30 int
+	c31 int
+	c32 int
+	c33 int
+	c34 int
+	c35 int
+	c36 int
+	c37 int
+	c38 int
+	c39 int
+	c40 int
+	c41 int
+	c42 int
+	c43 int
+	c44 int
+	c45 int
+	c46 int
+	c47 int
+	c48 int
+	c49 int
+	c50 int
+	c51 int
+	c52 int
+	c53 int
+	c54 int
+	c55 int
+	c56 int
+	c57 int
+	c58 int
+	c59 int
+	c60 int
+	c61 int
+	c62 int
+	c63 int
+	c64 int
+	c65 int
+	c66 int
+	c67 int
+	c68 int
+	c69 int
+	c70 int
+	c71 int
+	c72 int
+	c73 int
+	c74 int
+	c75 int
+	c76 int
+	c77 int
+	c78 int
+	c79 int
+	c80 int
+	c81 int
+	c82 int
+	c83 int
+	c84 int
+	c85 int
+	c86 int
+	c87 int
+	c88 int
+	c89 int
+	c90 int
+	c91 int
+	c92 int
+	c93 int
+	c94 int
+	c95 int
+	c96 int
+	c97 int
+	c98 int
+	c99 int
+	c100 int
+	c101 int
+	c102 int
+	c103 int
+	c104 int
+	c105 int
+	c106 int
+	c107 int
+	c108 int
+	c109 int
+	c110 int
+	c111 int
+	c112 int
+	c113 int
+	c114 int
+	c115 int
+	c116 int
+	c117 int
+	c118 int
+	c119 int
+	c120 int
+	c121 int
+	c122 int
+	c123 int
+	c124 int
+	c125 int
+	c126 int
+	c127 int
+	c128 int
+	c129 int
+}
+
+func main() {
+	a := Punto{1, 2}
+	b := a
+	b.x = 10
+	fmt.Println(a.x)
+	fmt.Println(b.x)
+
+	var c Punto = b
+	c.y += 5
+	fmt.Println(c.y)
+	fmt.Println(b.y)
+
+	a = c
+	fmt.Println(a.x + a.y)
+
+	a = Punto{a.y, a.x}
+	fmt.Println(a.x)
+	fmt.Println(a.y)
+
+	m := Marca{true, false, true}
+	n := m
+	n.fija = false
+	fmt.Println(m.fija)
+	fmt.Println(n.activa)
+
+	k := Caja{"caja", a, Punto{3, 4}, m}
+	fmt.Println(k.nombre)
+	fmt.Println(k.esquina.x)
+	fmt.Println(k.tam.y)
+	fmt.Println(k.marca.activa)
+
+	k.esquina = k.tam
+	k.tam = Punto{k.tam.y, k.tam.x}
+	fmt.Println(k.esquina.x)
+	fmt.Println(k.tam.x)
+	p := k.tam
+	fmt.Println(p.y)
+
+	k2 := k
+	k2.marca.visible = true
+	fmt.Println(k.marca.visible)
+	fmt.Println(k2.marca.visible)
+
+	var g Grande
+	fmt.Println(g.c0 + g.c129)
+	g.c0 = 7
+	g.c129 = 9
+	h := g
+	g.c129 = 1
+	fmt.Println(h.c0 + h.c129)
+	g = h
+	fmt.Println(g.c129)
+	var z Grande
+	g = z
+	fmt.Println(g.c0 + g.c129)
+}
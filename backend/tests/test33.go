@@ -0,0 +1,120 @@
+package main
+
+import "fmt"
+
+type Punto struct {
+	x int
+	y int
+}
+
+type Marca struct {
+	activa bool
+	visible bool
+	fija bool
+}
+
+type Rect struct {
+	nombre string
+	min Punto
+	max Punto
+}
+
+type Ficha struct {
+	antes bool
+	marca Marca
+	despues bool
+	id int
+}
+
+func nuevoPunto(x int, y int) Punto {
+	return Punto{x, y}
+}
+
+func sumar(a Punto, b Punto) Punto {
+	a.x += b.x
+	a.y += b.y
+	return a
+}
+
+func escalar(p Punto, k int) Punto {
+	p.x *= k
+	p.y *= k
+	return p
+}
+
+func marcar(v bool) Marca {
+	return Marca{v, !v, v}
+}
+
+func nuevoRect(nombre string, a Punto, b Punto) Rect {
+	return Rect{nombre, a, b}
+}
+
+func mover(r Rect, d Punto) Rect {
+	r.min = sumar(r.min, d)
+	r.max = sumar(r.max, d)
+	return r
+}
+
+func moverDos(r Rect, d Punto) Rect {
+	return mover(mover(r, d), d)
+}
+
+func area(r Rect) int {
+	return (r.max.x - r.min.x) * (r.max.y - r.min.y)
+}
+
+func muchos(a int, b int, c int, p Punto, q Punto, r Punto, d int) int {
+	return a + b + c + p.x + p.y + q.x + q.y + r.x + r.y + d
+}
+
+func acumular(p Punto, n int) Punto {
+	if n == 0 {
+		return p
+	}
+	return acumular(sumar(p, Punto{1, 2}), n-1)
+}
+
+func main() {
+	p := nuevoPunto(3, 4)
+	fmt.Println(p.x)
+	fmt.Println(p.y)
+
+	q := sumar(p, Punto{10, 20})
+	fmt.Println(q.x)
+	fmt.Println(q.y)
+	fmt.Println(p.x)
+
+	s := sumar(nuevoPunto(1, 1), escalar(p, 2))
+	fmt.Println(s.x + s.y)
+
+	m := marcar(true)
+	fmt.Println(m.activa)
+	fmt.Println(m.visible)
+
+	f := Ficha{true, m, true, 7}
+	f.marca = marcar(false)
+	fmt.Println(f.antes)
+	fmt.Println(f.marca.activa)
+	fmt.Println(f.marca.visible)
+	fmt.Println(f.despues)
+	fmt.Println(f.id)
+
+	r := nuevoRect("caja", Punto{0, 0}, Punto{4, 5})
+	fmt.Println(r.nombre)
+	fmt.Println(area(r))
+	r2 := mover(r, Punto{1, 1})
+	fmt.Println(r2.min.x)
+	fmt.Println(r.min.x)
+	r = moverDos(r, Punto{2, 3})
+	fmt.Println(r.max.x)
+	fmt.Println(r.max.y)
+	fmt.Println(area(mover(r, p)))
+	mover(r, p)
+
+	fmt.Println(muchos(1, 2, 3, Punto{4, 5}, p, q, 100))
+
+	a := acumular(Punto{0, 0}, 1000)
+	fmt.Println(a.x)
+	fmt.Println(a.y)
+}
@@ -0,0 +1,81 @@
+package main
+
+import "fmt"
+
+type Persona struct {
+	nombre string
+	edad int
+	apellido string
+}
+
+func saludo(nombre string) string {
+	return "hola " + nombre
+}
+
+func juntar(a string, b string, c string, d string) string {
+	return a + b + c + d
+}
+
+func largoTotal(a string, n int, b string, c string, d string) int {
+	return len(a) + n + len(b) + len(c) + len(d)
+}
+
+func completo(p Persona) string {
+	return p.nombre + " " + p.apellido
+}
+
+func repetir(s string, n int, acc string) string {
+	if n == 0 {
+		return acc
+	}
+	return repetir(s, n-1, acc+s)
+}
+
+func main() {
+	s := "abc"
+	fmt.Println(len(s))
+	fmt.Println(len("hola mundo"))
+	fmt.Println(len(s + "de"))
+
+	t := s + "def"
+	fmt.Println(t)
+	fmt.Println(len(t))
+
+	var vacio string
+	fmt.Println(len(vacio))
+	vacio += "x"
+	vacio += "yz"
+	fmt.Println(vacio)
+
+	fmt.Println(s == "abc")
+	fmt.Println(s != "abc")
+	fmt.Println(s == "ab")
+	fmt.Println(s == "abcd")
+	if t == "abcdef" {
+		fmt.Println("iguales")
+	}
+	if s != t {
+		fmt.Println("distintos")
+	}
+
+	fmt.Println(saludo("gopher"))
+	fmt.Println(juntar("a", s, saludo("b"), t))
+	fmt.Println(largoTotal("uno", 10, "dos", "tres", "cuatro"))
+
+	p := Persona{"Ada", 36, "Lovelace"}
+	fmt.Println(p.nombre)
+	fmt.Println(len(p.apellido))
+	p.nombre = "Augusta"
+	fmt.Println(completo(p))
+	p.apellido += " King"
+	fmt.Println(p.apellido)
+	fmt.Println(p.edad)
+
+	fmt.Println(repetir("ab", 3, ""))
+
+	cuenta := 0
+	for i := 0; i < 5; i++ {
+		cuenta += len(t)
+	}
+	fmt.Println(cuenta)
+}
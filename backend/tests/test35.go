@@ -0,0 +1,61 @@
+package main
+
+import "fmt"
+
+func repetir(s string, veces int) string {
+	r := ""
+	for i := 0; i < veces; i++ {
+		r += s
+	}
+	return r
+}
+
+func numeros(n int) string {
+	var r string
+	for i := 0; i < n; i++ {
+		if i%2 == 0 {
+			r = r + "par "
+		} else {
+			r += "impar "
+		}
+	}
+	return r
+}
+
+func main() {
+	fmt.Println(repetir("ab", 5))
+	fmt.Println(len(repetir("x", 20000)))
+	fmt.Println(numeros(4))
+
+	r := "a"
+	copias := ""
+	for i := 0; i < 4; i++ {
+		t := r
+		r += "b"
+		t += "c"
+		copias += t
+		copias += "|"
+	}
+	fmt.Println(r)
+	fmt.Println(copias)
+
+	s := ""
+	for i := 0; i < 3; i++ {
+		s += "xy"
+	}
+	u := s
+	s = "nuevo"
+	for i := 0; i < 2; i++ {
+		s += "!"
+	}
+	u += "?"
+	fmt.Println(s)
+	fmt.Println(u)
+
+	d := ""
+	for i := 0; i < 3; i++ {
+		d += d + "o"
+	}
+	fmt.Println(d)
+	fmt.Println(d == "ooooooo")
+}
@@ -0,0 +1,43 @@
+package main
+
+import "fmt"
+
+func envolver(s string) string {
+	return "[" + s + "]"
+}
+
+func tres(a string, b string, c string) string {
+	return a + "-" + b + "-" + c
+}
+
+func main() {
+	saludo := "hola" + ", " + "mundo" + "!"
+	fmt.Println(saludo)
+	fmt.Println(len("a" + "bc" + "def"))
+
+	a := "uno"
+	b := "dos"
+	c := "tres"
+	fmt.Println(a + " " + b + " " + c)
+	fmt.Println(a + (b + c) + "!")
+	fmt.Println("<" + envolver(a + b) + envolver(c) + ">")
+	fmt.Println(tres(a + b, "x" + "y", envolver(a) + c))
+
+	d := a + b + c + a + b + c + a + b + c + a
+	fmt.Println(d)
+	fmt.Println(len(d))
+
+	s := "inicio"
+	s += ":" + a + ":" + b
+	fmt.Println(s)
+
+	r := ""
+	for i := 0; i < 3; i++ {
+		r = r + a + "," + b + ";"
+	}
+	fmt.Println(r)
+
+	fmt.Println(a + b + c == "unodostres")
+	fmt.Println("" + "" + "")
+	fmt.Println(len("" + a + ""))
+}
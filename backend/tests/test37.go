@@ -0,0 +1,116 @@
+package main
+
+import "fmt"
+
+func igual(a string, b string) bool {
+	return a == b
+}
+
+func revisar(p string) {
+	if p == "" {
+		fmt.Println(0)
+	}
+	if p == "a" {
+		fmt.Println(1)
+	}
+	if p == "ab" {
+		fmt.Println(2)
+	}
+	if p == "abc" {
+		fmt.Println(3)
+	}
+	if p == "abcd" {
+		fmt.Println(4)
+	}
+	if p == "abcde" {
+		fmt.Println(5)
+	}
+	if p == "abcdef" {
+		fmt.Println(6)
+	}
+	if p == "abcdefg" {
+		fmt.Println(7)
+	}
+	if p == "abcdefgh" {
+		fmt.Println(8)
+	}
+	if p == "abcdefghi" {
+		fmt.Println(9)
+	}
+	if p == "abcdefghij" {
+		fmt.Println(10)
+	}
+	if p == "abcdefghijk" {
+		fmt.Println(11)
+	}
+	if p == "abcdefghijkl" {
+		fmt.Println(12)
+	}
+	if p == "abcdefghijklm" {
+		fmt.Println(13)
+	}
+	if p == "abcdefghijklmn" {
+		fmt.Println(14)
+	}
+	if p == "abcdefghijklmno" {
+		fmt.Println(15)
+	}
+	if p == "abcdefghijklmnop" {
+		fmt.Println(16)
+	}
+	if p == "abcdefghijklmnopq" {
+		fmt.Println(17)
+	}
+	if "abcdefghijklmnop" != p {
+	} else {
+		fmt.Println("dieciseis")
+	}
+	if p == "abcdefghijklmnoX" {
+		fmt.Println("con X")
+	}
+}
+
+func main() {
+	base := "abcdefghijklmnopq"
+	revisar("")
+	revisar("a")
+	revisar("ab")
+	revisar("abc")
+	revisar("abcd")
+	revisar("abcde")
+	revisar("abcdef")
+	revisar("abcdefg")
+	revisar("abcdefgh")
+	revisar("abcdefghi")
+	revisar("abcdefghij")
+	revisar("abcdefghijk")
+	revisar("abcdefghijkl")
+	revisar("abcdefghijklm")
+	revisar("abcdefghijklmn")
+	revisar("abcdefghijklmno")
+	revisar("abcdefghijklmnop")
+	revisar("abcdefghijklmnopq")
+	revisar("abcdefghijklmnoX")
+
+	q := "abcdefgh"
+	fmt.Println(q == "abcdefgh")
+	fmt.Println(q == "abcdefgX")
+	fmt.Println(q == "Xbcdefgh")
+	fmt.Println(q != "abcdefgh")
+	fmt.Println("abcdefgh" == "abcdefgh")
+	fmt.Println("ab" != "abc")
+
+	n := "ñandú"
+	fmt.Println(n == "ñandú")
+	fmt.Println(n == "ñandu")
+	fmt.Println(len(n))
+
+	largo := base + base
+	otro := base + base
+	fmt.Println(largo == otro)
+	fmt.Println(igual(largo, otro + "!"))
+	fmt.Println(igual(largo, largo))
+	fmt.Println(largo != otro)
+	fmt.Println(igual("", ""))
+	fmt.Println(igual(base, "abcdefghijklmnopZ"))
+}
@@ -0,0 +1,84 @@
+package main
+
+import "fmt"
+
+type Linea struct {
+	texto string
+	numero int
+}
+
+func contarPalabras(s string) int {
+	palabras := 0
+	dentro := false
+	for i := 0; i < len(s); i++ {
+		if s[i] == 32 {
+			dentro = false
+		} else {
+			if !dentro {
+				palabras++
+			}
+			dentro = true
+		}
+	}
+	return palabras
+}
+
+func primeraPalabra(s string) string {
+	for i := 0; i < len(s); i++ {
+		if s[i] == 32 {
+			return s[:i]
+		}
+	}
+	return s
+}
+
+func invertir(s string) string {
+	r := ""
+	for i := len(s); i > 0; i-- {
+		r += s[i-1 : i]
+	}
+	return r
+}
+
+func main() {
+	s := "hola mundo cruel"
+	fmt.Println(s[0])
+	fmt.Println(s[len(s)-1])
+	fmt.Println("abc"[1])
+	fmt.Println(s[5:10])
+	fmt.Println(s[11:])
+	fmt.Println(s[:4])
+	fmt.Println(s[:])
+	fmt.Println(len(s[5:10]))
+	fmt.Println(len(s[3:3]))
+	fmt.Println(s[5:10] == "mundo")
+	fmt.Println(s[5:10] + "!" + s[:4])
+
+	fmt.Println(contarPalabras(s))
+	fmt.Println(contarPalabras("  uno  dos tres   "))
+	fmt.Println(primeraPalabra(s))
+	fmt.Println(primeraPalabra("sola"))
+	fmt.Println(invertir("gopher"))
+
+	l := Linea{"clave=valor", 7}
+	fmt.Println(l.texto[6:])
+	fmt.Println(l.texto[0:5])
+
+	i := 2
+	j := 7
+	sub := s[i:j]
+	fmt.Println(sub)
+	fmt.Println(sub[1:3])
+	fmt.Println(s[i+1 : j+1])
+
+	b := ""
+	for k := 0; k < 4; k++ {
+		b += "ab"
+	}
+	vista := b[2:4]
+	b += "zz"
+	fmt.Println(vista)
+	fmt.Println(b)
+
+	fmt.Println(s[len(s)])
+}
@@ -0,0 +1,21 @@
+package main
+
+import "fmt"
+
+func main() {
+	fmt.Println("enteros:", 0, 7, -7, 10, 99, 100, -100, 1000000)
+	q := 1073741824 * 1073741824 * 4
+	maximo := q - 1 + q
+	fmt.Println(maximo)
+	fmt.Println(-maximo - 1)
+	fmt.Println(true, false)
+	fmt.Println()
+	fmt.Println("a", "", "b")
+	nombre := "Ada"
+	fmt.Println("hola", nombre, "tenés", 36, "años", 36 > 18)
+	suma := 0
+	for i := 1; i <= 5; i++ {
+		suma += i
+		fmt.Println(i, suma)
+	}
+}
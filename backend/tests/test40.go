@@ -0,0 +1,20 @@
+package main
+
+import "fmt"
+
+func main() {
+	fmt.Println("hola", 42, true)
+	fmt.Println(-7, false, "fin")
+	fmt.Println("a" + "b" + "c", 1)
+	fmt.Println()
+	x := 5
+	s := "medio"
+	fmt.Println("antes", 1, x, "entre", -2, s, "despues", false)
+	fmt.Println(x, "solo")
+	fmt.Println("solo", x)
+	fmt.Println(x + 1, -x, !true)
+	fmt.Println("", "")
+	for i := 0; i < 3; i++ {
+		fmt.Println("vuelta", i, "de", 3)
+	}
+}
@@ -0,0 +1,36 @@
+package main
+
+import "fmt"
+
+func duplicar(s string, veces int) string {
+	for i := 0; i < veces; i++ {
+		s = s + s
+	}
+	return s
+}
+
+func main() {
+	base := "0123456789abcdef"
+	chico := base + "!"
+	mediano := duplicar(base, 8)
+	grande := duplicar(base, 14)
+	fmt.Println(len(chico), len(mediano), len(grande))
+	fmt.Println(mediano[4094:4096], grande[262142:])
+
+	junto := chico + mediano + grande + chico
+	fmt.Println(len(junto), junto[16:18], junto[len(junto)-2:])
+
+	total := 0
+	for i := 0; i < 50000; i++ {
+		a := base[i%16:] + chico[:i%8]
+		b := mediano[:i%4000] + a
+		total += len(a) + len(b)
+	}
+	fmt.Println(total)
+
+	acc := ""
+	for i := 0; i < 30000; i++ {
+		acc += base[i%16 : i%16+1]
+	}
+	fmt.Println(len(acc), acc[29990:])
+}
@@ -0,0 +1,70 @@
+package main
+
+import "fmt"
+
+type Nodo struct {
+	nombre string
+	peso int
+	extra string
+	otro string
+}
+
+func pieza(i int) string {
+	d := "abcdefghijklmnopqrstuvwxyz"
+	return d[i%26:i%26+1] + d[(i+7)%26:(i+7)%26+1]
+}
+
+func profundo(n int, s string) string {
+	if n == 0 {
+		return s + "."
+	}
+	t := s + pieza(n)
+	r := profundo(n-1, t)
+	return r + s[0:1]
+}
+
+func siete(a int, b int, c int, d int, e int, f int, x Nodo, y string) string {
+	return x.nombre + x.extra + pieza(a+b+c+d+e+f) + x.otro + y
+}
+
+func grande(n int) string {
+	s := "0123456789abcdef"
+	for i := 0; i < n; i++ {
+		s = s + s
+	}
+	return s
+}
+
+func main() {
+	acc := ""
+	for i := 0; i < 4000; i++ {
+		acc += pieza(i) + pieza(i+1)
+	}
+	fmt.Println(len(acc), acc[15990:])
+
+	vista := grande(13)[100:110]
+	for i := 0; i < 2000; i++ {
+		basura := grande(10) + pieza(i)
+		if len(basura) == 0 {
+			fmt.Println("nunca")
+		}
+	}
+	fmt.Println(vista)
+
+	cuenta := 0
+	for i := 0; i < 300; i++ {
+		p := profundo(20, pieza(i))
+		n := Nodo{"" + pieza(i), i, pieza(i+1) + "!", pieza(i+2) + "?"}
+		q := siete(1, 2, 3, 4, 5, i, n, pieza(i)+pieza(i+3))
+		if pieza(i)+"x" == pieza(i+26)+"x" {
+			cuenta += 1
+		}
+		cuenta += len(p) + len(q) + len(n.extra)
+		if i%100 == 0 {
+			fmt.Println(p, q, n.nombre, n.extra, n.otro)
+		}
+		m := pieza(i)[len(pieza(i+1))-1:]
+		cuenta += len(m)
+	}
+	fmt.Println(cuenta)
+}
@@ -0,0 +1,78 @@
+package main
+
+import "fmt"
+
+type Caja struct {
+	s string
+	n int
+}
+
+func primero(s string) string {
+	return s[0:1]
+}
+
+func medio(s string, t string) int {
+	return nivel(s+t, t)
+}
+
+func nivel(a string, b string) int {
+	if a == b {
+		return 0
+	}
+	return len(a) - len(b)
+}
+
+func pasar(s string) string {
+	return devolver(s)
+}
+
+func devolver(s string) string {
+	return s
+}
+
+func guardar(c Caja, s string) Caja {
+	c.s = s
+	return c
+}
+
+func acumular(n int) int {
+	acc := ""
+	for i := 0; i < n; i++ {
+		acc += "xy"
+	}
+	return len(acc)
+}
+
+func acumular2(n int) string {
+	var acc string
+	for i := 0; i < n; i++ {
+		acc += "ab" + "c"
+	}
+	return acc
+}
+
+func main() {
+	d := "abcdefghijklmnopqrstuvwxyz"
+	viejo := ""
+	cajas := Caja{"" + "x", 0}
+	total := 0
+	for i := 0; i < 40; i++ {
+		s := d[i%20:i%20+3] + "-"
+		p := primero(s + "@")
+		q := pasar(s + "#")
+		acc := ""
+		for j := 0; j < 5; j++ {
+			acc += d[j : j+2]
+		}
+		copia := acc
+		acc += "ZZ"
+		cajas = guardar(cajas, s+"caja")
+		total += medio(s, d[i%5:i%5+2]) + len(copia)
+		if i%7 == 0 {
+			fmt.Println(s, p, q, acc, copia, viejo, cajas.s)
+		}
+		viejo = q + p
+	}
+	fmt.Println(total, viejo, cajas.s)
+	fmt.Println(acumular(10), acumular(200), len(acumular2(100)), acumular2(3))
+}
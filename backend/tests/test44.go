@@ -0,0 +1,116 @@
+package main
+
+import "fmt"
+
+var contador int
+var limite int = 10 * 4 + 2
+var negativo int = -limite / 3
+var saludo string = "hola" + " " + "mundo"
+var largo int = len(saludo)
+var activo bool = largo > 5 && !false
+var origen Punto = Punto{3, 4}
+var etiqueta Nombre = Nombre{"ej", 7}
+var vacio string
+var derivado int = doble(limite)
+var despues int = limite + 1
+var lista string = repetir("ab", 3)
+var grande Grande
+
+type Punto struct {
+	x int
+	y int
+}
+
+type Nombre struct {
+	s string
+	n int
+}
+
+type Grande struct {
+	a int
+	b int
+	c int
+	d string
+}
+
+func doble(n int) int {
+	contador++
+	return n * 2
+}
+
+func repetir(s string, n int) string {
+	r := ""
+	for i := 0; i < n; i++ {
+		r += s
+	}
+	return r
+}
+
+func tocar() {
+	contador = contador + 10
+	saludo = saludo + "!"
+}
+
+func leer() int {
+	return contador
+}
+
+func rotar() Grande {
+	return Grande{grande.b, grande.c, grande.a, grande.d + "."}
+}
+
+func mover(p Punto) Punto {
+	origen.x = origen.x + 100
+	return Punto{p.y, p.x}
+}
+
+func sumar(n int) int {
+	limite = limite + n
+	return limite
+}
+
+func sombra() int {
+	contador := 5
+	return contador + leer()
+}
+
+func main() {
+	fmt.Println(contador, limite, negativo, saludo, largo, activo)
+	fmt.Println(origen.x, origen.y, etiqueta.s, etiqueta.n, len(vacio))
+	fmt.Println(derivado, despues, lista)
+	tocar()
+	tocar()
+	fmt.Println(contador, saludo, leer())
+
+	total := 0
+	for i := 0; i < 5; i++ {
+		total = total + limite*2
+		sumar(1)
+	}
+	fmt.Println(total, limite)
+
+	for contador = 0; contador < 3; contador++ {
+		fmt.Println("vuelta", contador)
+	}
+
+	grande = Grande{1, 2, 3, "d"}
+	grande = rotar()
+	grande = rotar()
+	fmt.Println(grande.a, grande.b, grande.c, grande.d)
+	origen = mover(origen)
+	fmt.Println(origen.x, origen.y)
+	fmt.Println(sombra())
+
+	for i := 0; i < 20000; i++ {
+		vacio = saludo + "-" + etiqueta.s
+		etiqueta.s = vacio[0:3] + etiqueta.s[0:1]
+	}
+	fmt.Println(vacio, etiqueta.s)
+
+	basura := ""
+	for i := 0; i < 150000; i++ {
+		basura = basura + "xy"
+		basura = basura[1:2]
+	}
+	fmt.Println(saludo, lista, etiqueta.s, grande.d, basura)
+}
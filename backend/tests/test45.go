@@ -0,0 +1,96 @@
+package main
+
+import "fmt"
+
+var escala int = 3 * 7
+var nombre string = "go" + "lang"
+var modo bool
+var usos int
+
+type Par struct {
+	a int
+	b string
+}
+
+func medir(s string) int {
+	usos++
+	return len(s) * escala
+}
+
+func sumar(x int, y int) int {
+	return 2*3 + x + y*4 - 10/5
+}
+
+func clasificar(n int) string {
+	limite := 100
+	if n > limite {
+		return "grande"
+	}
+	if n%2 == 0 {
+		return "par"
+	}
+	return "impar"
+}
+
+func main() {
+	fmt.Println(2*3+4, 7/2, -7/2, 7%3, -7%3, 2*3 == 6)
+	fmt.Println(len("hola"), "abc"+"def", "hola"[1], "mundial"[1:4], "x" == "x", 3 >= 4)
+
+	maximo := 9223372036854775807
+	fmt.Println(maximo, maximo+1, maximo*2, -maximo-1)
+	minimo := -maximo - 1
+	fmt.Println(minimo, minimo+maximo, minimo/2, 5000000000*3)
+
+	base := 10
+	paso := 3
+	var cero int
+	var vacio string
+	total := 0
+	for i := 0; i < base; i++ {
+		total = total + i*paso + cero + len(vacio)
+	}
+	fmt.Println(total, base, paso)
+
+	saludo := "hola"
+	{
+		saludo := saludo + " mundo"
+		fmt.Println(saludo, len(saludo), saludo[5:])
+	}
+	fmt.Println(saludo, saludo[0], len(saludo[1:3]))
+
+	x := 5
+	x = x + 1
+	y := x * 2
+	fmt.Println(x, y, sumar(x, y), sumar(1, 2))
+
+	depurar := false
+	if depurar {
+		fmt.Println("no se imprime")
+	} else {
+		fmt.Println("sin depurar")
+	}
+	if !depurar && x > 3 {
+		fmt.Println("rama viva")
+	}
+	if depurar || x < 3 {
+		fmt.Println("no se imprime")
+	}
+	if true && y > 10 {
+		fmt.Println("y grande")
+	}
+
+	fmt.Println(escala, nombre, modo, medir(nombre), usos)
+	fmt.Println(clasificar(7), clasificar(8), clasificar(1000))
+
+	p := Par{1 + escala, nombre[0:2] + "!"}
+	fmt.Println(p.a, p.b)
+
+	operar(17)
+	operar(-9)
+}
+
+func operar(n int) {
+	fmt.Println(n+6, n-5, n*3, n/4, n%4, n > 16, n <= 16, 6+n, 3*n)
+	grande := n + 4000000000
+	fmt.Println(grande, grande > 4000000000, grande*2, grande/4000000000)
+}
@@ -0,0 +1,100 @@
+package main
+
+import "fmt"
+
+var llamadas int
+var base int = 7
+
+type Punto struct {
+	x int
+	y int
+}
+
+func fib(n int) int {
+	if n < 2 {
+		return n
+	}
+	return fib(n-1) + fib(n-2)
+}
+
+func factorial(n int) int {
+	r := 1
+	for i := 2; i <= n; i++ {
+		r *= i
+	}
+	return r
+}
+
+func invertir(s string) string {
+	r := ""
+	for i := len(s) - 1; i >= 0; i-- {
+		r += s[i : i+1]
+	}
+	return r
+}
+
+func contarVocales(s string) int {
+	n := 0
+	for i := 0; i < len(s); i++ {
+		c := s[i]
+		if c == 97 || c == 101 || c == 105 || c == 111 || c == 117 {
+			n++
+		}
+	}
+	return n
+}
+
+func esPrimo(n int) bool {
+	if n < 2 {
+		return false
+	}
+	for d := 2; d*d <= n; d++ {
+		if n%d == 0 {
+			return false
+		}
+	}
+	return true
+}
+
+func sumaHasta(n int) int {
+	if n == 0 {
+		return 0
+	}
+	return n + sumaHasta(n-1)
+}
+
+func contar(n int) int {
+	llamadas++
+	return n * 2
+}
+
+func conBase(n int) int {
+	return n + base
+}
+
+func norma(p Punto) int {
+	return p.x*p.x + p.y*p.y
+}
+
+func dividir(a int, b int) int {
+	if b == 0 {
+		return -1
+	}
+	return a / b
+}
+
+func main() {
+	fmt.Println(fib(30), fib(32), factorial(20), factorial(25))
+	fmt.Println(invertir("compilador"), contarVocales("murcielago"), esPrimo(7919), esPrimo(7917))
+	fmt.Println(sumaHasta(100), sumaHasta(5000))
+	fmt.Println(contar(4), contar(4), llamadas)
+	fmt.Println(conBase(1), dividir(7, 0), dividir(7, 2))
+	fmt.Println(norma(Punto{3, 4}))
+	n := 12
+	fmt.Println(fib(n), factorial(n-2), invertir("ab"+"cd"))
+	total := 0
+	for i := 0; i < 5; i++ {
+		total = total + fib(i) + fib(10)
+	}
+	fmt.Println(total)
+}
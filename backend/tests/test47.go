@@ -0,0 +1,91 @@
+package main
+
+import "fmt"
+
+var llamadas int
+
+func marcar(nombre string, valor bool) bool {
+	llamadas++
+	fmt.Println("evalúa", nombre)
+	return valor
+}
+
+func positivo(n int) bool {
+	return n > 0
+}
+
+func main() {
+	if false && marcar("a", true) {
+		fmt.Println("no se imprime")
+	}
+	if true || marcar("b", false) {
+		fmt.Println("or corto")
+	}
+	x := 3
+	if x > 5 && marcar("c", true) {
+		fmt.Println("no se imprime")
+	}
+	if x < 5 || marcar("d", true) {
+		fmt.Println("x chico")
+	}
+	if x > 1 && marcar("e", true) {
+		fmt.Println("ambos")
+	}
+	if x > 5 || marcar("f", false) {
+		fmt.Println("no se imprime")
+	}
+	fmt.Println(llamadas)
+
+	r := x == 0 && marcar("g", true)
+	s := x == 3 || marcar("h", true)
+	t := x != 0 && marcar("i", false)
+	fmt.Println(r, s, t, llamadas)
+
+	for i := 0; i < 6; i++ {
+		a := i%2 == 0
+		b := i > 2
+		c := i == 5
+		if !(a && b) || c {
+			fmt.Println(i, "sí")
+		} else {
+			fmt.Println(i, "no")
+		}
+		if !(a || b) && !c {
+			fmt.Println(i, "ninguno")
+		}
+	}
+
+	n := 0
+	for !(n >= 4 && positivo(n)) || n == 4 {
+		n++
+	}
+	fmt.Println(n)
+
+	k := 10
+	for k > 0 && !(k%7 == 0 || k%4 == 0) {
+		k--
+	}
+	fmt.Println(k)
+
+	v := true
+	w := 7
+	fmt.Println(!v, !!v, -w, - -w, !(w > 3), -(w - 10))
+	fmt.Println(!(x > 1 && x < 2), -x*2, !positivo(-w))
+	u := !v || x > 2
+	fmt.Println(u, !u, -(-x))
+
+	if marcar("j", false) || marcar("k", true) {
+		fmt.Println("segundo operando")
+	}
+	m := 7
+	for m := 1; m < 3 && marcar("l", true); m++ {
+		fmt.Println(m * 3)
+	}
+	for i := 0; i < 2; i++ {
+		m := 10
+		if !(m > 5 && i > 0) {
+			fmt.Println(m + i)
+		}
+	}
+	fmt.Println(m, llamadas)
+}
@@ -0,0 +1,53 @@
+package main
+
+import "fmt"
+
+var maximo int
+var minimo int
+
+func main() {
+	total := 0
+	for i := 0; i < 20000000000; i += 3000000000 {
+		total += i * 3
+	}
+	fmt.Println(total)
+	n := 0
+	for j := 9223372036854775800; j > 9223372036854775000; j -= 100 {
+		n++
+	}
+	fmt.Println(n)
+	m := 0
+	for k := 9223372036854775000; k < 9223372036854775806; k++ {
+		m += k % 7
+	}
+	fmt.Println(m)
+	c := 0
+	for k := -9223372036854775800; k > -9223372036854775807; k-- {
+		c++
+	}
+	fmt.Println(c)
+	s := 0
+	for k := 0; k < 40; k += 7 {
+		s += k * 5
+	}
+	fmt.Println(s)
+	maximo = 9223372036854775807
+	minimo = -maximo - 1
+	alto := maximo
+	cuenta := 0
+	for i := alto - 5; i < alto; i++ {
+		cuenta++
+	}
+	fmt.Println(cuenta)
+	bajo := minimo
+	cuenta = 0
+	for i := bajo + 6; i > bajo; i-- {
+		cuenta += 2
+	}
+	fmt.Println(cuenta)
+	cuenta = 0
+	for i := alto - 20; i <= alto-3; i += 3 {
+		cuenta += i % 10
+	}
+	fmt.Println(cuenta)
+}
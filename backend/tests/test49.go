@@ -0,0 +1,31 @@
+package main
+
+import "fmt"
+
+func primero(a int, b int) int {
+	return a
+}
+
+func doble(s string, n int) int {
+	return n * 2
+}
+
+func elegir(n int, b bool) int {
+	return n
+}
+
+func descartar(n int) {
+	fmt.Println("descartar", n)
+}
+
+func main() {
+	s := "abc"
+	d := 5
+	fmt.Println(primero(4, 7), doble(s, 3), primero(5, 10/d), doble(s[1:], 2))
+	fmt.Println(primero(6, d%3), doble(s[0:2], len(s)))
+	descartar(primero(7, d*2))
+	y := elegir(1, s[2] == s[0])
+	fmt.Println(y)
+	z := elegir(2, s[9] == s[0])
+	fmt.Println("no se imprime", z)
+}
@@ -0,0 +1,121 @@
+package main
+
+import "fmt"
+
+var tres int
+var cuatro int
+
+func suma3(a int, b int, c int) int {
+	return a + b + c
+}
+
+func quince(a int, b int) int {
+	c := a + b
+	d := a - b
+	e := a * b
+	f := c + d
+	g := d * e
+	h := e - f
+	i := f + g
+	j := g - h
+	k := h * 2
+	l := i + j
+	m := j - k
+	n := k + l
+	o := l * m
+	return o - n
+}
+
+func justo(a int, b int) int {
+	c := a + b
+	d := a - b
+	e := a * b
+	f := c + d
+	g := d * e
+	h := e - f
+	i := f + g
+	j := g - h
+	k := h * 2
+	l := i + j
+	m := j - k
+	n := k + l
+	o := l * m
+	return (a*b + c*d) - o + n
+}
+
+func pasado(a int, b int) int {
+	c := a + b
+	d := a - b
+	e := a * b
+	f := c + d
+	g := d * e
+	h := e - f
+	i := f + g
+	j := g - h
+	k := h * 2
+	l := i + j
+	m := j - k
+	n := k + l
+	o := l * m
+	return (a*b + c*d) - (e*f - g*h) + (i*j + k*l) - (m*n + o)
+}
+
+func diecisiete(a int, b int) int {
+	c := a + b
+	d := a - b
+	e := a * b
+	f := c + d
+	g := d * e
+	h := e - f
+	i := f + g
+	j := g - h
+	k := h * 2
+	l := i + j
+	m := j - k
+	n := k + l
+	o := l * m
+	p := m + n
+	q := n - o
+	return (a*b + c*d) - (e*f - g*h) + (i*j + k*l) - (m*n + o*p) + q
+}
+
+func contar(s string, limite int) int {
+	total := 0
+	for i := 0; i < len(s); i++ {
+		if s[i] == s[0] || i > limite {
+			total++
+		} else {
+			total += 2
+		}
+	}
+	return total
+}
+
+func mayor(a int, b int) bool {
+	return a > b && !(a == 0)
+}
+
+func acumular(n int) int {
+	total := 0
+	for i := 0; i < n; i++ {
+		total += quince(i, n-i) % 1000
+		total += justo(n, i) % 1000
+		total -= pasado(i, 3) % 1000
+		total -= diecisiete(n-i, i) % 1000
+		if mayor(i, n/2) {
+			total += suma3(i, i, i)
+		}
+		total += contar("abracadabra", i)
+	}
+	return total
+}
+
+func main() {
+	tres = 3
+	cuatro = 4
+	fmt.Println(suma3(1, 2, tres), quince(tres, cuatro), diecisiete(tres, cuatro))
+	fmt.Println(justo(tres, cuatro), pasado(tres, cuatro), justo(-9, cuatro), pasado(cuatro, -9))
+	fmt.Println(quince(-5, cuatro+7), diecisiete(cuatro*3, -7), contar("banana", tres))
+	fmt.Println(mayor(tres, 2), mayor(0, -1), mayor(2, tres))
+	fmt.Println(acumular(cuatro*2+2), acumular(cuatro*6+1))
+}
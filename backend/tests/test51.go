@@ -0,0 +1,113 @@
+package main
+
+import "fmt"
+
+var pasos int
+var semilla int
+
+func tocar(n int) int {
+	pasos++
+	return n
+}
+
+func main() {
+	semilla = 3
+	a := semilla * 2
+	b := semilla + 4
+	c := semilla
+	n := semilla + 2
+	total := 0
+	for i := 0; i < n; i++ {
+		total += a*b + c
+	}
+	fmt.Println(total)
+
+	total = 0
+	for i := 0; i < n; i++ {
+		total += a * b
+		a++
+		b -= 2
+	}
+	fmt.Println(total, a, b)
+
+	a = 4
+	b = 5
+	total = 0
+	for i := 0; i < semilla; i++ {
+		total += a * b
+		a := 100
+		total += a * b
+		{
+			b := i + 1
+			total += a * b
+		}
+		total -= a*b + 1
+	}
+	fmt.Println(total, a, b)
+
+	d := semilla - 3
+	s := "hola"
+	r := 0
+	for i := 0; i <= n; i++ {
+		if d != 0 {
+			r += 100 / d
+		}
+		if i > 10 && s[9] == s[0] {
+			r += 1000
+		}
+		if len(s) > 9 {
+			r += len(s[3:9])
+		}
+		r += i % 4
+	}
+	fmt.Println(r)
+
+	k := semilla + 4
+	suma := 0
+	for i := 0; i < n*4; i += 3 {
+		suma += i * k
+		suma += k * i
+		suma -= 2 * i
+	}
+	fmt.Println(suma)
+	suma = 0
+	for i := 30; i > 0; i -= 4 {
+		suma += i * k
+		i--
+		suma += i * 5
+	}
+	fmt.Println(suma)
+	suma = 0
+	for i := 0; i*k < 100; i++ {
+		suma += i*k + tocar(i)
+	}
+	fmt.Println(suma, pasos)
+	suma = 0
+	for i := 0; i < n*2; i++ {
+		suma += i * k
+		if i == 4 {
+			k = 2
+		}
+	}
+	fmt.Println(suma, k)
+
+	x := 10
+	x += 5
+	x -= 3
+	fmt.Println(x)
+	x *= 4
+	x /= 3
+	x %= 7
+	fmt.Println(x)
+	acum := 100
+	for i := 1; i <= 4; i++ {
+		acum -= i
+		acum += i * 2
+	}
+	fmt.Println(acum)
+	palabra := "a"
+	for i := 0; i < 3; i++ {
+		palabra += "b"
+	}
+	fmt.Println(palabra)
+}
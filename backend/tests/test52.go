@@ -0,0 +1,28 @@
+package main
+
+import "fmt"
+
+var uno int
+
+func dividir(a int, b int) int {
+	return a / b
+}
+
+func resto(a int, b int) int {
+	return a % b
+}
+
+func main() {
+	for i := 0; i < 3; i++ {
+		fmt.Println("antes", i)
+	}
+	uno = 1
+	d := uno + 3
+	fmt.Println(dividir(100, d), resto(100, d-3))
+	x := 60
+	x /= d - 1
+	x %= d + 3
+	fmt.Println(x)
+	fmt.Println(dividir(7, uno-1))
+	fmt.Println("no se imprime")
+}
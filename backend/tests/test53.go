@@ -0,0 +1,17 @@
+package main
+
+import "fmt"
+
+var desde int
+var hasta int
+
+func main() {
+	s := "abc"
+	desde = 1
+	hasta = 3
+	fmt.Println(s[desde:hasta], s[desde:], s[:hasta-1])
+	desde = 5
+	hasta = 6
+	fmt.Println("antes del pánico")
+	fmt.Println(len(s[desde:hasta]))
+}
@@ -0,0 +1,36 @@
+package main
+
+import "fmt"
+
+var vistos int
+
+func ambos(c bool, a int) bool {
+	return c && a > 0
+}
+
+func alguno(c bool, a int) bool {
+	return c || a > 0
+}
+
+func ver(n int) int {
+	vistos++
+	fmt.Println("ver", n)
+	return n
+}
+
+func main() {
+	r := ambos(false, ver(1))
+	fmt.Println(r, vistos)
+	s := alguno(true, ver(2))
+	fmt.Println(s, vistos)
+	t := ambos(true, ver(3))
+	fmt.Println(t, vistos)
+	if ambos(false, ver(4)) {
+		fmt.Println("no se imprime")
+	}
+	v := ambos(false, ver(5)) || alguno(true, ver(6))
+	fmt.Println(v, vistos)
+	d := vistos - 6
+	u := alguno(true, 10/d)
+	fmt.Println("no se imprime", u)
+}
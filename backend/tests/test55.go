@@ -0,0 +1,38 @@
+package main
+
+import "fmt"
+
+var nunca bool
+
+func boom(n int) string {
+	r := "x"
+	for i := 0; i < n; i++ {
+		r = r + r
+	}
+	return r
+}
+
+func crecer(s string, n int) string {
+	if n == 0 {
+		return s
+	}
+	return crecer(s+s, n-1)
+}
+
+func eco(s string, n int) string {
+	for i := 0; i < n; i++ {
+		s += "ab"
+	}
+	return s
+}
+
+func main() {
+	if nunca {
+		fmt.Println(len(boom(40)))
+		fmt.Println(len(crecer("yy", 60)))
+	}
+	fmt.Println(len(boom(10)), len(crecer("ab", 5)))
+	fmt.Println(boom(3), eco("", 4))
+	fmt.Println(len(eco("z", 40000)))
+	fmt.Println(3)
+}
@@ -79,8 +79,10 @@ void PrintVisitor::visit(FunctionCallExp* exp) {
 void PrintVisitor::visit(StructLiteralExp* exp) {
     cout << exp->typeName << "{";
     bool first = true;
+    auto field = exp->fields.begin();
     for (auto val : exp->values) {
         if (!first) cout << ", ";
+        if (field != exp->fields.end()) cout << *field++ << ": ";
         val->accept(this);
         first = false;
     }
@@ -218,6 +220,10 @@ void PrintVisitor::visit(VarDecl* stmt) {
     }
 }
 
+void PrintVisitor::visit(BlockStmt* stmt) {
+    stmt->block->accept(this);
+}
+
 // Declaraciones
 void PrintVisitor::visit(TypeDecl* decl) {
     cout << "type " << decl->name << " ";
@@ -26,6 +26,7 @@ class IfStmt;
 class ForStmt;
 class ReturnStmt;
 class VarDecl;
+class BlockStmt;
 
 class TypeDecl;
 class FuncDecl;
@@ -62,6 +63,7 @@ public:
     virtual void visit(ForStmt* stmt) = 0;
     virtual void visit(ReturnStmt* stmt) = 0;
     virtual void visit(VarDecl* stmt) = 0;
+    virtual void visit(BlockStmt* stmt) = 0;
     
     // Declaraciones
     virtual void visit(TypeDecl* decl) = 0;
@@ -108,6 +110,7 @@ public:
     void visit(ForStmt* stmt) override;
     void visit(ReturnStmt* stmt) override;
     void visit(VarDecl* stmt) override;
+    void visit(BlockStmt* stmt) override;
     
     // Declaraciones
     void visit(TypeDecl* decl) override;